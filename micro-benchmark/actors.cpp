@@ -1,7 +1,12 @@
 #include "main.hpp"
 
+#include "latency_histogram.hpp"
+
 #include "caf/event_based_actor.hpp"
+#include "caf/exit_reason.hpp"
 #include "caf/message.hpp"
+#include "caf/scoped_actor.hpp"
+#include "caf/send.hpp"
 
 #if CAF_VERSION >= 1900
 #  include "caf/async/spsc_buffer.hpp"
@@ -12,9 +17,24 @@
 #  include "caf/attach_stream_source.hpp"
 #endif
 
+#if CAF_VERSION < 10000
+#  include "caf/group.hpp"
+#endif
+
 #include <caf/detail/double_ended_queue.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 using namespace caf;
 using namespace std::literals;
@@ -25,8 +45,11 @@ public:
 
   int some_int = 42;
 
+  latency_histogram latencies;
+
   void SetUp(const benchmark::State&) override {
     context = make_caf_context();
+    latencies.reset();
   }
 
   void TearDown(const ::benchmark::State&) override {
@@ -45,6 +68,550 @@ BENCHMARK_F(actors, spawn_and_await)(benchmark::State& state) {
   }
 }
 
+// -- fan-in: many senders, one receiver ---------------------------------------
+
+// Total number of messages that the receiver gets per iteration.
+constexpr size_t fan_in_messages = 100'000;
+
+struct fan_in_stats {
+  using clock_type = std::chrono::steady_clock;
+
+  clock_type::time_point first;
+
+  clock_type::time_point last;
+};
+
+template <class T>
+behavior fan_in_receiver(event_based_actor* self, size_t num_messages,
+                         fan_in_stats* stats) {
+  auto remaining = std::make_shared<size_t>(num_messages);
+  return {
+    [self, num_messages, remaining, stats](const T&) {
+      auto now = fan_in_stats::clock_type::now();
+      if (*remaining == num_messages)
+        stats->first = now;
+      if (--*remaining == 0) {
+        stats->last = now;
+        self->quit();
+      }
+    },
+  };
+}
+
+template <class T>
+void fan_in_sender(event_based_actor* self, actor receiver, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    self->send(receiver, make_sample<T>());
+}
+
+// Reports the aggregate rate as items/s and the rate at which the receiver
+// processes messages (from the first to the last message) as a user counter.
+// The receiver gets `per_iteration` messages in each iteration.
+void report_fan_in(benchmark::State& state, size_t per_iteration,
+                   fan_in_stats::clock_type::duration receiver_time) {
+  auto num_messages = static_cast<int64_t>(state.iterations())
+                      * static_cast<int64_t>(per_iteration);
+  state.SetItemsProcessed(num_messages);
+  auto secs = std::chrono::duration<double>(receiver_time).count();
+  if (secs > 0)
+    state.counters["receiver_rate"] = static_cast<double>(num_messages) / secs;
+}
+
+// Sends from `n` actors with `fan_in_messages / n` messages each.
+template <class T>
+void run_fan_in_actors(benchmark::State& state, actor_system& sys, size_t n) {
+  fan_in_stats stats;
+  fan_in_stats::clock_type::duration receiver_time{0};
+  auto per_sender = fan_in_messages / n;
+  for (auto _ : state) {
+    auto receiver = sys.spawn(fan_in_receiver<T>, per_sender * n, &stats);
+    for (size_t i = 0; i < n; ++i)
+      sys.spawn(fan_in_sender<T>, receiver, per_sender);
+    sys.await_all_actors_done();
+    receiver_time += stats.last - stats.first;
+  }
+  report_fan_in(state, per_sender * n, receiver_time);
+}
+
+// Sends from `n` threads via anon_send.
+template <class T>
+void run_fan_in_threads(benchmark::State& state, actor_system& sys, size_t n) {
+  fan_in_stats stats;
+  fan_in_stats::clock_type::duration receiver_time{0};
+  auto per_sender = fan_in_messages / n;
+  for (auto _ : state) {
+    auto receiver = sys.spawn(fan_in_receiver<T>, per_sender * n, &stats);
+    std::vector<std::thread> senders;
+    for (size_t i = 0; i < n; ++i)
+      senders.emplace_back([receiver, per_sender] {
+        for (size_t j = 0; j < per_sender; ++j)
+          anon_send(receiver, make_sample<T>());
+      });
+    for (auto& sender : senders)
+      sender.join();
+    sys.await_all_actors_done();
+    receiver_time += stats.last - stats.first;
+  }
+  report_fan_in(state, per_sender * n, receiver_time);
+}
+
+// Calls `f` with a default-constructed value of the message type selected by
+// the second argument: 0 = int32_t, 1 = foo, 2 = bar.
+template <class F>
+void with_message_type(benchmark::State& state, F f) {
+  switch (state.range(1)) {
+    case 0:
+      f(int32_t{});
+      break;
+    case 1:
+      f(foo{});
+      break;
+    default:
+      f(bar{});
+  }
+}
+
+BENCHMARK_DEFINE_F(actors, fan_in_actors)(benchmark::State& state) {
+  auto n = static_cast<size_t>(state.range(0));
+  with_message_type(state, [&](auto x) {
+    run_fan_in_actors<decltype(x)>(state, context->sys, n);
+  });
+}
+
+BENCHMARK_REGISTER_F(actors, fan_in_actors)
+  ->ArgsProduct({{1, 16, 256, 1024}, {0, 1, 2}})
+  ->ArgNames({"senders", "type"});
+
+BENCHMARK_DEFINE_F(actors, fan_in_threads)(benchmark::State& state) {
+  auto n = static_cast<size_t>(state.range(0));
+  with_message_type(state, [&](auto x) {
+    run_fan_in_threads<decltype(x)>(state, context->sys, n);
+  });
+}
+
+BENCHMARK_REGISTER_F(actors, fan_in_threads)
+  ->ArgsProduct({{1, 2, 4, 8, 16}, {0, 1, 2}})
+  ->ArgNames({"senders", "type"});
+
+// -- fan-out: one sender, many receivers --------------------------------------
+
+// Blocks the benchmark thread until all recipients got their message.
+class countdown {
+public:
+  void reset(size_t n) {
+    remaining_ = n;
+  }
+
+  void count_down() {
+    if (--remaining_ == 0) {
+      std::unique_lock<std::mutex> guard{mtx_};
+      cv_.notify_all();
+    }
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> guard{mtx_};
+    cv_.wait(guard, [this] { return remaining_.load() == 0; });
+  }
+
+private:
+  std::atomic<size_t> remaining_{0};
+  std::mutex mtx_;
+  std::condition_variable cv_;
+};
+
+// Tracks delivery of the broadcast payload to all recipients.
+struct fan_out_probe {
+  countdown done;
+
+  // Points to the payload in the message that the sender broadcasts.
+  const counted_payload* original = nullptr;
+
+  // Counts recipients that got the original payload instead of a copy.
+  std::atomic<size_t> shared{0};
+
+  void received(const counted_payload& x) {
+    if (&x == original)
+      ++shared;
+    done.count_down();
+  }
+};
+
+// Counts down once after initialization and then once per message. Taking the
+// payload by mutable reference forces CAF to detach shared messages, i.e., to
+// copy the payload unless the recipient holds the only reference.
+template <bool Mutable>
+behavior fan_out_recipient(event_based_actor*, fan_out_probe* probe) {
+  using payload_ref = std::conditional_t<Mutable, counted_payload&,
+                                         const counted_payload&>;
+  probe->done.count_down();
+  return {
+    [probe](payload_ref x) { probe->received(x); },
+  };
+}
+
+message make_fan_out_message() {
+  return make_message(counted_payload{std::vector<int>(256, 42)});
+}
+
+// Spawns `n` recipients with `spawn_recipient`, calls `broadcast` once per
+// iteration and reports the number of payload copies, the number of
+// recipients that received the original payload and the growth of the
+// resident set size.
+template <class Spawn, class Broadcast>
+void run_fan_out(benchmark::State& state, actor_system& sys,
+                 Spawn spawn_recipient, Broadcast broadcast) {
+  auto n = static_cast<size_t>(state.range(0));
+  auto rss_before = resident_memory();
+  fan_out_probe probe;
+  probe.done.reset(n);
+  std::vector<actor> recipients;
+  recipients.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    recipients.emplace_back(spawn_recipient(&probe));
+  probe.done.wait();
+  counted_payload::copies = 0;
+  probe.shared = 0;
+  for (auto _ : state) {
+    probe.done.reset(n);
+    {
+      // Drop our reference before waiting to allow the last recipient to
+      // modify the payload without copying it.
+      auto msg = make_fan_out_message();
+      probe.original = &msg.get_as<counted_payload>(0);
+      broadcast(recipients, msg);
+    }
+    probe.done.wait();
+  }
+  auto deliveries = static_cast<double>(state.iterations())
+                    * static_cast<double>(n);
+  state.counters["payload_copies"] = benchmark::Counter(
+    static_cast<double>(counted_payload::copies.load()),
+    benchmark::Counter::kAvgIterations);
+  state.counters["shared_payloads"] = benchmark::Counter(
+    static_cast<double>(probe.shared.load()),
+    benchmark::Counter::kAvgIterations);
+  auto rss_after = resident_memory();
+  state.counters["rss_growth_bytes"]
+    = rss_after > rss_before ? static_cast<double>(rss_after - rss_before)
+                             : 0.0;
+  state.SetItemsProcessed(static_cast<int64_t>(deliveries));
+  for (auto& hdl : recipients)
+    anon_send_exit(hdl, exit_reason::user_shutdown);
+  sys.await_all_actors_done();
+}
+
+// Passes the number of recipients as first argument.
+void recipient_counts(benchmark::internal::Benchmark* bench) {
+  for (auto n : {1, 100, 10'000, 100'000})
+    bench->Arg(n);
+  bench->ArgName("recipients");
+}
+
+// Sends the same message to each recipient individually.
+template <bool Mutable>
+void run_fan_out_send(benchmark::State& state, actor_system& sys) {
+  scoped_actor self{sys};
+  run_fan_out(
+    state, sys,
+    [&sys](fan_out_probe* probe) {
+      return sys.spawn(fan_out_recipient<Mutable>, probe);
+    },
+    [&self](std::vector<actor>& recipients, const message& msg) {
+      for (auto& hdl : recipients)
+        self->send(hdl, msg);
+    });
+}
+
+BENCHMARK_DEFINE_F(actors, fan_out_send)(benchmark::State& state) {
+  run_fan_out_send<false>(state, context->sys);
+}
+
+BENCHMARK_REGISTER_F(actors, fan_out_send)
+  ->Apply(recipient_counts)
+  ->UseRealTime();
+
+// Like fan_out_send, but recipients take the payload by mutable reference and
+// thus detach the shared message.
+BENCHMARK_DEFINE_F(actors, fan_out_send_mutable)(benchmark::State& state) {
+  run_fan_out_send<true>(state, context->sys);
+}
+
+BENCHMARK_REGISTER_F(actors, fan_out_send_mutable)
+  ->Apply(recipient_counts)
+  ->UseRealTime();
+
+#if CAF_VERSION < 10000
+
+behavior fan_out_group_recipient(event_based_actor* self,
+                                 fan_out_probe* probe, group grp) {
+  self->join(grp);
+  return fan_out_recipient<false>(self, probe);
+}
+
+// Sends the message once to a local group that all recipients joined. CAF
+// 1.0 no longer has groups.
+BENCHMARK_DEFINE_F(actors, fan_out_group)(benchmark::State& state) {
+  auto& sys = context->sys;
+  scoped_actor self{sys};
+  auto grp = sys.groups().anonymous();
+  run_fan_out(
+    state, sys,
+    [&sys, &grp](fan_out_probe* probe) {
+      return sys.spawn(fan_out_group_recipient, probe, grp);
+    },
+    [&self, &grp](std::vector<actor>&, const message& msg) {
+      self->send(grp, msg);
+    });
+}
+
+BENCHMARK_REGISTER_F(actors, fan_out_group)
+  ->Apply(recipient_counts)
+  ->UseRealTime();
+
+#endif
+
+// -- mass spawn of idle actors ------------------------------------------------
+
+// Idles with a handful of handlers after signaling that it is initialized.
+behavior idle_actor(event_based_actor*, countdown* ready) {
+  ready->count_down();
+  return {
+    [](int32_t x) { return x; },
+    [](const foo& x) { return x.a + x.b; },
+    [](const bar& x) { return x.b; },
+    [](const std::string&) {},
+  };
+}
+
+// Measures the time for spawning and initializing N actors. Reports the RSS
+// growth per actor and the rate at which the actors shut down once released.
+// The allocation counters (--count_allocations) additionally report the heap
+// usage via peak_live_bytes.
+BENCHMARK_DEFINE_F(actors, mass_spawn)(benchmark::State& state) {
+  using clock_type = std::chrono::steady_clock;
+  using fractional_seconds = std::chrono::duration<double>;
+  auto n = static_cast<size_t>(state.range(0));
+  auto& sys = context->sys;
+  std::vector<actor> hdls;
+  hdls.reserve(n);
+  countdown ready;
+  size_t max_rss_growth = 0;
+  clock_type::duration teardown_time{0};
+  for (auto _ : state) {
+    auto rss_before = resident_memory();
+    auto t0 = clock_type::now();
+    ready.reset(n);
+    for (size_t i = 0; i < n; ++i)
+      hdls.emplace_back(sys.spawn(idle_actor, &ready));
+    ready.wait();
+    auto t1 = clock_type::now();
+    state.SetIterationTime(fractional_seconds{t1 - t0}.count());
+    auto rss_after = resident_memory();
+    if (rss_after > rss_before)
+      max_rss_growth = std::max(max_rss_growth, rss_after - rss_before);
+    // Dropping the last reference terminates the idle actors.
+    auto t2 = clock_type::now();
+    hdls.clear();
+    sys.await_all_actors_done();
+    teardown_time += clock_type::now() - t2;
+  }
+  auto num_actors = static_cast<double>(state.iterations())
+                    * static_cast<double>(n);
+  state.SetItemsProcessed(static_cast<int64_t>(num_actors));
+  state.counters["rss_per_actor"] = static_cast<double>(max_rss_growth)
+                                    / static_cast<double>(n);
+  auto teardown_secs = fractional_seconds{teardown_time}.count();
+  if (teardown_secs > 0)
+    state.counters["teardown_rate"] = num_actors / teardown_secs;
+}
+
+BENCHMARK_REGISTER_F(actors, mass_spawn)
+  ->Arg(10'000)
+  ->Arg(100'000)
+  ->Arg(1'000'000)
+  ->ArgName("actors")
+  ->UseManualTime()
+  ->Unit(benchmark::kMillisecond);
+
+// -- parallel and recursive spawning ------------------------------------------
+
+// Spawns `branching` children on the first message, passes the decremented
+// depth to each child and quits.
+template <class Kind>
+behavior spawn_tree_node(event_based_actor* self, int32_t branching) {
+  return {
+    [self, branching](int32_t depth) {
+      if (depth > 0)
+        for (int32_t i = 0; i < branching; ++i)
+          self->send(Kind::spawn(*self, branching), depth - 1);
+      self->quit();
+    },
+  };
+}
+
+// The kinds of actors that we compare. Each kind spawns a tree node from
+// either an actor system or an actor.
+
+struct function_kind {
+  template <class Parent>
+  static actor spawn(Parent& parent, int32_t branching) {
+    return parent.spawn(spawn_tree_node<function_kind>, branching);
+  }
+};
+
+struct class_kind {
+  template <class Parent>
+  static actor spawn(Parent& parent, int32_t branching);
+};
+
+class spawn_tree_actor : public event_based_actor {
+public:
+  spawn_tree_actor(actor_config& cfg, int32_t branching)
+    : event_based_actor(cfg), branching_(branching) {
+    // nop
+  }
+
+  behavior make_behavior() override {
+    return spawn_tree_node<class_kind>(this, branching_);
+  }
+
+private:
+  int32_t branching_;
+};
+
+template <class Parent>
+actor class_kind::spawn(Parent& parent, int32_t branching) {
+  return parent.template spawn<spawn_tree_actor>(branching);
+}
+
+struct detached_kind {
+  template <class Parent>
+  static actor spawn(Parent& parent, int32_t branching) {
+    return parent.template spawn<detached>(spawn_tree_node<detached_kind>,
+                                           branching);
+  }
+};
+
+#if CAF_VERSION < 10000
+
+struct lazy_init_kind {
+  template <class Parent>
+  static actor spawn(Parent& parent, int32_t branching) {
+    return parent.template spawn<lazy_init>(spawn_tree_node<lazy_init_kind>,
+                                            branching);
+  }
+};
+
+constexpr int64_t num_spawn_kinds = 4;
+
+#else
+
+constexpr int64_t num_spawn_kinds = 3;
+
+#endif
+
+// Calls `f` with a value of the actor kind selected by the second argument:
+// 0 = function-based, 1 = class-based, 2 = detached, 3 = lazy_init (CAF < 1.0
+// only).
+template <class F>
+void with_spawn_kind(benchmark::State& state, F f) {
+  switch (state.range(1)) {
+    case 0:
+      f(function_kind{});
+      break;
+    case 1:
+      f(class_kind{});
+      break;
+#if CAF_VERSION < 10000
+    case 3:
+      f(lazy_init_kind{});
+      break;
+#endif
+    default:
+      f(detached_kind{});
+  }
+}
+
+// Passes the worker count, the actor kind, the tree depth and the branching
+// factor as arguments. The tree shapes have a similar number of nodes.
+void spawn_tree_args(benchmark::internal::Benchmark* bench) {
+  for (auto workers : worker_count_values())
+    for (int64_t kind = 0; kind < num_spawn_kinds; ++kind)
+      for (auto [depth, branching] : {std::pair{2, 24}, std::pair{3, 8},
+                                      std::pair{8, 2}})
+        bench->Args({workers, kind, depth, branching});
+  bench->ArgNames({"workers", "kind", "depth", "branching"});
+}
+
+// Passes the worker count (also used as number of spawning threads) and the
+// actor kind as arguments.
+void parallel_spawn_args(benchmark::internal::Benchmark* bench) {
+  for (auto workers : worker_count_values())
+    for (int64_t kind = 0; kind < num_spawn_kinds; ++kind)
+      bench->Args({workers, kind});
+  bench->ArgNames({"workers", "kind"});
+}
+
+class spawning : public base_fixture {
+public:
+  caf_context_ptr context;
+
+  void SetUp(const benchmark::State& state) override {
+    context = make_caf_context(static_cast<size_t>(state.range(0)));
+  }
+
+  void TearDown(const ::benchmark::State&) override {
+    context.reset();
+  }
+};
+
+// Each node of the tree spawns its children.
+BENCHMARK_DEFINE_F(spawning, tree)(benchmark::State& state) {
+  auto depth = static_cast<int32_t>(state.range(2));
+  auto branching = static_cast<int32_t>(state.range(3));
+  int64_t num_nodes = 0;
+  for (int64_t i = 0, level = 1; i <= depth; ++i, level *= branching)
+    num_nodes += level;
+  auto& sys = context->sys;
+  with_spawn_kind(state, [&](auto kind) {
+    using kind_type = decltype(kind);
+    for (auto _ : state) {
+      anon_send(kind_type::spawn(sys, branching), depth);
+      sys.await_all_actors_done();
+    }
+  });
+  state.SetItemsProcessed(state.iterations() * num_nodes);
+}
+
+BENCHMARK_REGISTER_F(spawning, tree)->Apply(spawn_tree_args);
+
+// N threads spawn actors concurrently, one per scheduler worker.
+BENCHMARK_DEFINE_F(spawning, parallel)(benchmark::State& state) {
+  constexpr size_t spawns_per_thread = 1'000;
+  auto num_threads = static_cast<size_t>(state.range(0));
+  auto& sys = context->sys;
+  with_spawn_kind(state, [&](auto kind) {
+    using kind_type = decltype(kind);
+    for (auto _ : state) {
+      std::vector<std::thread> threads;
+      for (size_t i = 0; i < num_threads; ++i)
+        threads.emplace_back([&sys] {
+          for (size_t j = 0; j < spawns_per_thread; ++j)
+            anon_send(kind_type::spawn(sys, 0), int32_t{0});
+        });
+      for (auto& thread : threads)
+        thread.join();
+      sys.await_all_actors_done();
+    }
+  });
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                          * static_cast<int64_t>(num_threads
+                                                 * spawns_per_thread));
+}
+
+BENCHMARK_REGISTER_F(spawning, parallel)->Apply(parallel_spawn_args);
+
 #if CAF_VERSION >= 1900
 
 using namespace caf::async;
@@ -87,34 +654,118 @@ BENCHMARK_DEFINE_F(actors, int_flow)(benchmark::State& state) {
 
 BENCHMARK_REGISTER_F(actors, int_flow)->Arg(1'000)->Arg(10'000)->Arg(100'000);
 
-void source(event_based_actor* self, size_t num_items, actor snk) {
+// Batching and backpressure settings for streams.
+struct stream_params {
+  // Maximum time that the source waits before emitting a partial batch.
+  timespan max_delay = 5ms;
+
+  // Maximum number of items per batch.
+  size_t max_items_per_batch = 50;
+
+  // Capacity of the buffer at the sink.
+  size_t buffer_size = 100;
+
+  // Minimum free space in the buffer before the sink requests more items.
+  size_t request_threshold = 50;
+};
+
+void source(event_based_actor* self, size_t num_items, stream_params params,
+            actor snk) {
   auto stream_hdl = self
                       ->make_observable() //
                       .iota(0)
                       .take(num_items)
-                      .to_stream("benchmark", 5ms, 50);
+                      .to_stream("benchmark", params.max_delay,
+                                 params.max_items_per_batch);
   self->send(snk, stream_hdl);
 }
 
-behavior sink(event_based_actor* self) {
+behavior sink(event_based_actor* self, stream_params params) {
   return {
     [=](stream input) {
-      self->observe_as<int>(input, 100, 50).for_each([](int) {});
+      self
+        ->observe_as<int>(input, params.buffer_size, params.request_threshold)
+        .for_each([](int) {});
     },
   };
 }
+
 BENCHMARK_DEFINE_F(actors, int_stream)(benchmark::State& state) {
   auto num_items = static_cast<size_t>(state.range(0));
   using actor_t = event_based_actor;
   for (auto _ : state) {
     auto& sys = context->sys;
-    sys.spawn(source, num_items, sys.spawn(sink));
+    sys.spawn(source, num_items, stream_params{},
+              sys.spawn(sink, stream_params{}));
     sys.await_all_actors_done();
   }
 }
 
 BENCHMARK_REGISTER_F(actors, int_stream)->Arg(1'000)->Arg(10'000)->Arg(100'000);
 
+int64_t now_ns() {
+  auto t = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+}
+
+// Like source, but emits the current time instead of an integer sequence.
+void timestamp_source(event_based_actor* self, size_t num_items,
+                      stream_params params, actor snk) {
+  auto stream_hdl = self
+                      ->make_observable() //
+                      .iota(0)
+                      .take(num_items)
+                      .map([](int) { return now_ns(); })
+                      .to_stream("benchmark", params.max_delay,
+                                 params.max_items_per_batch);
+  self->send(snk, stream_hdl);
+}
+
+// Records the time between emitting and consuming each item.
+behavior timestamp_sink(event_based_actor* self, stream_params params,
+                        latency_histogram* latencies) {
+  return {
+    [=](stream input) {
+      self
+        ->observe_as<int64_t>(input, params.buffer_size,
+                              params.request_threshold)
+        .for_each([latencies](int64_t t0) {
+          latencies->record(static_cast<uint64_t>(now_ns() - t0));
+        });
+    },
+  };
+}
+
+// Sweeps the stream parameters. The request threshold is given in percent of
+// the buffer size.
+BENCHMARK_DEFINE_F(actors, int_stream_params)(benchmark::State& state) {
+  constexpr size_t num_items = 100'000;
+  stream_params params;
+  params.max_delay = std::chrono::milliseconds{state.range(0)};
+  params.max_items_per_batch = static_cast<size_t>(state.range(1));
+  params.buffer_size = static_cast<size_t>(state.range(2));
+  params.request_threshold = std::max(
+    params.buffer_size * static_cast<size_t>(state.range(3)) / 100, size_t{1});
+  auto& sys = context->sys;
+  for (auto _ : state) {
+    auto snk = sys.spawn(timestamp_sink, params, &latencies);
+    sys.spawn(timestamp_source, num_items, params, snk);
+    sys.await_all_actors_done();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                          * static_cast<int64_t>(num_items));
+  latencies.report(state, "actors/int_stream_params/delay_ms:"
+                            + std::to_string(state.range(0))
+                            + "/batch:" + std::to_string(state.range(1))
+                            + "/buffer:" + std::to_string(state.range(2))
+                            + "/threshold_pct:"
+                            + std::to_string(state.range(3)));
+}
+
+BENCHMARK_REGISTER_F(actors, int_stream_params)
+  ->ArgsProduct({{1, 5, 25}, {10, 50, 250}, {100, 1000}, {10, 50}})
+  ->ArgNames({"delay_ms", "batch", "buffer", "threshold_pct"});
+
 #else
 
 void source(event_based_actor* self, size_t num_items, actor snk) {
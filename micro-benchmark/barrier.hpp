@@ -1,18 +1,67 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#  include <immintrin.h>
+#endif
+
+enum class barrier_mode {
+  // Always blocks on a condition variable.
+  blocking,
+  // Spins for a while before falling back to blocking.
+  spinning,
+};
+
+// Set from the command line via --barrier=blocking|spinning.
+extern barrier_mode default_barrier_mode;
 
 // Drop-in replacement for std::barrier (based on the TS API as of 2020).
 class barrier {
 public:
+  // Number of spin iterations before a waiting thread goes to sleep. Spinning
+  // only makes sense if other threads can run in the meantime.
+  static int spin_limit() noexcept {
+    static const int result = std::thread::hardware_concurrency() > 1 ? 1 << 14
+                                                                      : 0;
+    return result;
+  }
+
   explicit barrier(ptrdiff_t num_threads)
     : num_threads_(num_threads), count_(0) {
     // nop
   }
 
+  // Selects the synchronization strategy. Must not be called while any thread
+  // waits on the barrier.
+  void mode(barrier_mode value) {
+    mode_ = value;
+  }
+
+  barrier_mode mode() const noexcept {
+    return mode_;
+  }
+
   void arrive_and_wait() {
+    if (mode_ == barrier_mode::spinning)
+      spin_and_wait();
+    else
+      block_and_wait();
+  }
+
+private:
+  static void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    _mm_pause();
+#endif
+  }
+
+  void block_and_wait() {
     std::unique_lock<std::mutex> guard{mx_};
     auto new_count = ++count_;
     if (new_count == num_threads_) {
@@ -25,9 +74,37 @@ public:
     }
   }
 
-private:
+  void spin_and_wait() {
+    auto gen = generation_.load(std::memory_order_acquire);
+    if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 == num_threads_) {
+      arrived_.store(0, std::memory_order_relaxed);
+      {
+        std::lock_guard<std::mutex> guard{mx_};
+        generation_.store(gen + 1, std::memory_order_release);
+      }
+      if (sleepers_.load() > 0)
+        cv_.notify_all();
+      return;
+    }
+    for (int i = 0, n = spin_limit(); i < n; ++i) {
+      if (generation_.load(std::memory_order_acquire) != gen)
+        return;
+      cpu_relax();
+    }
+    std::unique_lock<std::mutex> guard{mx_};
+    ++sleepers_;
+    cv_.wait(guard, [this, gen] { return generation_.load() != gen; });
+    --sleepers_;
+  }
+
+  barrier_mode mode_ = barrier_mode::blocking;
   ptrdiff_t num_threads_;
   std::mutex mx_;
   std::atomic<ptrdiff_t> count_;
   std::condition_variable cv_;
+
+  // State for the spinning mode.
+  std::atomic<ptrdiff_t> arrived_{0};
+  std::atomic<uint64_t> generation_{0};
+  std::atomic<int> sleepers_{0};
 };
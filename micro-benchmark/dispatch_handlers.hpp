@@ -0,0 +1,61 @@
+#pragma once
+
+#include "main.hpp"
+
+#include "caf/behavior.hpp"
+#include "caf/message.hpp"
+#include "caf/message_builder.hpp"
+#include "caf/message_handler.hpp"
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+
+// Types for generating up to 256 handlers with distinct signatures. Each
+// handler takes four arguments, i.e., handler I uses the base-4 digits of I to
+// select its argument types.
+using dispatch_types = std::tuple<int32_t, double, std::string, foo>;
+
+template <size_t I, size_t Digit>
+using dispatch_arg
+  = std::tuple_element_t<(I >> (2 * Digit)) % 4, dispatch_types>;
+
+// Creates handler I, which stores I + 1 to `invoked` when called.
+template <size_t I>
+auto make_dispatch_handler(size_t& invoked) {
+  return [&invoked](const dispatch_arg<I, 3>&, const dispatch_arg<I, 2>&,
+                    const dispatch_arg<I, 1>&,
+                    const dispatch_arg<I, 0>&) { invoked = I + 1; };
+}
+
+// Creates a behavior with one handler for each index in `Is`.
+template <size_t... Is>
+caf::behavior make_dispatch_behavior(size_t& invoked,
+                                     std::index_sequence<Is...>) {
+  return caf::behavior{make_dispatch_handler<Is>(invoked)...};
+}
+
+// Creates a message handler with one handler for each index in `Is`, shifted
+// by `Offset`.
+template <size_t Offset, size_t... Is>
+caf::message_handler make_dispatch_handlers(size_t& invoked,
+                                            std::index_sequence<Is...>) {
+  return caf::message_handler{make_dispatch_handler<Offset + Is>(invoked)...};
+}
+
+// Creates a message that matches handler I.
+template <size_t I>
+caf::message make_dispatch_message() {
+  return caf::make_message(dispatch_arg<I, 3>{}, dispatch_arg<I, 2>{},
+                           dispatch_arg<I, 1>{}, dispatch_arg<I, 0>{});
+}
+
+// Creates a message that matches handler I by using a message builder.
+template <size_t I>
+caf::message make_dynamic_dispatch_message() {
+  caf::message_builder mb;
+  mb.append_all(dispatch_arg<I, 3>{}, dispatch_arg<I, 2>{},
+                dispatch_arg<I, 1>{}, dispatch_arg<I, 0>{});
+  return mb.to_message();
+}
@@ -0,0 +1,192 @@
+#include "main.hpp"
+
+#if CAF_VERSION >= 1900
+
+#  include "caf/async/spsc_buffer.hpp"
+#  include "caf/cow_vector.hpp"
+#  include "caf/event_based_actor.hpp"
+#  include "caf/scheduled_actor/flow.hpp"
+
+#  include <algorithm>
+#  include <cstdint>
+#  include <memory>
+#  include <tuple>
+#  include <vector>
+
+using namespace caf;
+
+namespace {
+
+// Number of items that each flow emits per iteration.
+constexpr size_t num_items = 100'000;
+
+using count_ptr = std::shared_ptr<size_t>;
+
+// Creates `n` sources that emit `num_items / n` items each.
+std::vector<flow::observable<int>> make_inputs(event_based_actor* self,
+                                               size_t n) {
+  std::vector<flow::observable<int>> result;
+  for (size_t i = 0; i < n; ++i)
+    result.emplace_back(
+      self->make_observable().iota(0).take(num_items / n).as_observable());
+  return result;
+}
+
+} // namespace
+
+class flows : public base_fixture {
+public:
+  caf_context_ptr context;
+
+  void SetUp(const benchmark::State&) override {
+    context = make_caf_context();
+  }
+
+  void TearDown(const ::benchmark::State&) override {
+    context.reset();
+  }
+
+  // Spawns an actor that runs `init` once per iteration and waits for all
+  // flows to complete. The flows must increment the counter for each item
+  // that reaches the end of the pipeline.
+  template <class Init>
+  void run(benchmark::State& state, size_t expected, Init init) {
+    auto& sys = context->sys;
+    for (auto _ : state) {
+      auto count = std::make_shared<size_t>(0);
+      sys.spawn([init, count](event_based_actor* self) { init(self, count); });
+      sys.await_all_actors_done();
+      if (*count != expected) {
+        state.SkipWithError("Wrong number of items!");
+        break;
+      }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(expected));
+  }
+};
+
+// -- operators within a single actor ------------------------------------------
+
+// Applies one map and one filter step per level.
+BENCHMARK_DEFINE_F(flows, map_filter)(benchmark::State& state) {
+  auto depth = state.range(0);
+  run(state, num_items, [depth](event_based_actor* self, count_ptr count) {
+    auto obs = self->make_observable().iota(0).take(num_items).as_observable();
+    for (int64_t i = 0; i < depth; ++i)
+      obs = obs.map([](int x) { return x + 1; })
+              .filter([](int x) { return x > 0; })
+              .as_observable();
+    obs.for_each([count](int) { ++*count; });
+  });
+}
+
+BENCHMARK_REGISTER_F(flows, map_filter)
+  ->Arg(1)
+  ->Arg(4)
+  ->Arg(16)
+  ->ArgName("depth");
+
+BENCHMARK_F(flows, flat_map)(benchmark::State& state) {
+  run(state, num_items, [](event_based_actor* self, count_ptr count) {
+    self->make_observable()
+      .iota(0)
+      .take(num_items)
+      .as_observable()
+      .flat_map([self](int x) {
+        return self->make_observable().just(x).as_observable();
+      })
+      .for_each([count](int) { ++*count; });
+  });
+}
+
+BENCHMARK_DEFINE_F(flows, merge)(benchmark::State& state) {
+  auto n = static_cast<size_t>(state.range(0));
+  run(state, num_items / n * n, [n](event_based_actor* self, count_ptr count) {
+    self->make_observable()
+      .from_container(make_inputs(self, n))
+      .as_observable()
+      .merge()
+      .for_each([count](int) { ++*count; });
+  });
+}
+
+BENCHMARK_REGISTER_F(flows, merge)->Arg(2)->Arg(8)->Arg(32)->ArgName("inputs");
+
+BENCHMARK_DEFINE_F(flows, concat)(benchmark::State& state) {
+  auto n = static_cast<size_t>(state.range(0));
+  run(state, num_items / n * n, [n](event_based_actor* self, count_ptr count) {
+    self->make_observable()
+      .from_container(make_inputs(self, n))
+      .as_observable()
+      .concat()
+      .for_each([count](int) { ++*count; });
+  });
+}
+
+BENCHMARK_REGISTER_F(flows, concat)->Arg(2)->Arg(8)->Arg(32)->ArgName("inputs");
+
+BENCHMARK_DEFINE_F(flows, buffer)(benchmark::State& state) {
+  auto batch_size = static_cast<size_t>(state.range(0));
+  run(state, num_items, [batch_size](event_based_actor* self, count_ptr count) {
+    self->make_observable()
+      .iota(0)
+      .take(num_items)
+      .as_observable()
+      .buffer(batch_size)
+      .for_each([count](const cow_vector<int>& xs) { *count += xs.size(); });
+  });
+}
+
+BENCHMARK_REGISTER_F(flows, buffer)
+  ->Arg(1)
+  ->Arg(16)
+  ->Arg(256)
+  ->ArgName("batch_size");
+
+// -- hops between actors ------------------------------------------------------
+
+// Passes items from a source through a chain of actors to a sink. Each hop
+// goes through an SPSC buffer with the given capacity.
+BENCHMARK_DEFINE_F(flows, hops)(benchmark::State& state) {
+  auto num_actors = state.range(0);
+  auto capacity = static_cast<size_t>(state.range(1));
+  auto min_request_size = std::max(capacity / 4, size_t{1});
+  auto& sys = context->sys;
+  for (auto _ : state) {
+    auto count = std::make_shared<size_t>(0);
+    async::consumer_resource<int> rd;
+    async::producer_resource<int> wr;
+    std::tie(rd, wr)
+      = async::make_spsc_buffer_resource<int>(capacity, min_request_size);
+    sys.spawn([wr](event_based_actor* self) {
+      self->make_observable().iota(0).take(num_items).subscribe(wr);
+    });
+    for (int64_t i = 2; i < num_actors; ++i) {
+      async::consumer_resource<int> next_rd;
+      std::tie(next_rd, wr)
+        = async::make_spsc_buffer_resource<int>(capacity, min_request_size);
+      sys.spawn([rd, wr](event_based_actor* self) {
+        self->make_observable().from_resource(rd).subscribe(wr);
+      });
+      rd = std::move(next_rd);
+    }
+    sys.spawn([rd, count](event_based_actor* self) {
+      self->make_observable().from_resource(rd).for_each(
+        [count](int) { ++*count; });
+    });
+    sys.await_all_actors_done();
+    if (*count != num_items) {
+      state.SkipWithError("Wrong number of items!");
+      break;
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                          * static_cast<int64_t>(num_items));
+}
+
+BENCHMARK_REGISTER_F(flows, hops)
+  ->ArgsProduct({{2, 4, 8}, {16, 256, 4096}})
+  ->ArgNames({"actors", "capacity"});
+
+#endif
@@ -6,55 +6,793 @@
 #include <json/json.h>
 #include <nlohmann/json.hpp>
 #include <rapidjson/document.h>
+#include <rapidjson/reader.h>
 
 #include <benchmark/benchmark.h>
 
+#include <cstdio>
 #include <fstream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
-class json_bench : public base_fixture {
-public:
-  std::string input;
+// -- decoding into C++ structs with nlohmann::json ----------------------------
 
-  void SetUp(const benchmark::State&) override {
-    std::ifstream t{twitter_json_file};
-    if (!t) {
-      fprintf(stderr, "failed to load %s\n", twitter_json_file);
-      abort();
-    }
-    std::stringstream buffer;
-    buffer << t.rdbuf();
-    input = buffer.str();
-  }
-};
+// Note: nlohmann::json finds these overloads via ADL, i.e., they must live in
+// the same namespace as the types.
 
-BENCHMARK_F(json_bench, caf_parse)(benchmark::State& state) {
+template <class T>
+void get_optional(const nlohmann::json& j, const char* key,
+                  std::optional<T>& x) {
+  if (auto& val = j.at(key); val.is_null())
+    x.reset();
+  else
+    x = val.get<T>();
+}
+
+void from_json(const nlohmann::json& j, twitter_metadata& x) {
+  j.at("result_type").get_to(x.result_type);
+  j.at("iso_language_code").get_to(x.iso_language_code);
+}
+
+void from_json(const nlohmann::json& j, twitter_hashtag& x) {
+  j.at("text").get_to(x.text);
+  j.at("indices").get_to(x.indices);
+}
+
+void from_json(const nlohmann::json& j, twitter_user_mention& x) {
+  j.at("screen_name").get_to(x.screen_name);
+  j.at("name").get_to(x.name);
+  j.at("id").get_to(x.id);
+  j.at("id_str").get_to(x.id_str);
+  j.at("indices").get_to(x.indices);
+}
+
+void from_json(const nlohmann::json& j, twitter_entities& x) {
+  j.at("hashtags").get_to(x.hashtags);
+  j.at("user_mentions").get_to(x.user_mentions);
+}
+
+void from_json(const nlohmann::json& j, twitter_user& x) {
+  j.at("id").get_to(x.id);
+  j.at("id_str").get_to(x.id_str);
+  j.at("name").get_to(x.name);
+  j.at("screen_name").get_to(x.screen_name);
+  j.at("location").get_to(x.location);
+  j.at("description").get_to(x.description);
+  get_optional(j, "url", x.url);
+  j.at("protected").get_to(x.is_protected);
+  j.at("followers_count").get_to(x.followers_count);
+  j.at("friends_count").get_to(x.friends_count);
+  j.at("listed_count").get_to(x.listed_count);
+  j.at("created_at").get_to(x.created_at);
+  j.at("favourites_count").get_to(x.favourites_count);
+  j.at("verified").get_to(x.verified);
+  j.at("statuses_count").get_to(x.statuses_count);
+  j.at("lang").get_to(x.lang);
+}
+
+void from_json(const nlohmann::json& j, twitter_status& x) {
+  j.at("metadata").get_to(x.metadata);
+  j.at("created_at").get_to(x.created_at);
+  j.at("id").get_to(x.id);
+  j.at("id_str").get_to(x.id_str);
+  j.at("text").get_to(x.text);
+  j.at("source").get_to(x.source);
+  j.at("truncated").get_to(x.truncated);
+  get_optional(j, "in_reply_to_status_id", x.in_reply_to_status_id);
+  get_optional(j, "in_reply_to_screen_name", x.in_reply_to_screen_name);
+  j.at("user").get_to(x.user);
+  j.at("retweet_count").get_to(x.retweet_count);
+  j.at("favorite_count").get_to(x.favorite_count);
+  j.at("entities").get_to(x.entities);
+  j.at("favorited").get_to(x.favorited);
+  j.at("retweeted").get_to(x.retweeted);
+  j.at("lang").get_to(x.lang);
+}
+
+void from_json(const nlohmann::json& j, twitter_search_metadata& x) {
+  j.at("completed_in").get_to(x.completed_in);
+  j.at("max_id").get_to(x.max_id);
+  j.at("max_id_str").get_to(x.max_id_str);
+  j.at("next_results").get_to(x.next_results);
+  j.at("query").get_to(x.query);
+  j.at("refresh_url").get_to(x.refresh_url);
+  j.at("count").get_to(x.count);
+  j.at("since_id").get_to(x.since_id);
+  j.at("since_id_str").get_to(x.since_id_str);
+}
+
+void from_json(const nlohmann::json& j, twitter_result& x) {
+  j.at("statuses").get_to(x.statuses);
+  j.at("search_metadata").get_to(x.search_metadata);
+}
+
+namespace {
+
+// -- parsers under test -------------------------------------------------------
+
+void set_bytes_processed(benchmark::State& state, const std::string& input) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                          * static_cast<int64_t>(input.size()));
+}
+
+void run_caf_parse(benchmark::State& state, const std::string& input) {
   for (auto _ : state) {
     caf::json_reader reader;
     reader.load(input);
     benchmark::DoNotOptimize(reader);
   }
+  set_bytes_processed(state, input);
 }
 
-BENCHMARK_F(json_bench, rapidjson_parse)(benchmark::State& state) {
+void run_rapidjson_parse(benchmark::State& state, const std::string& input) {
   for (auto _ : state) {
     rapidjson::Document document;
     document.Parse(input.c_str());
     benchmark::DoNotOptimize(document);
   }
+  set_bytes_processed(state, input);
 }
 
-BENCHMARK_F(json_bench, nlohmann_parse)(benchmark::State& state) {
+void run_nlohmann_parse(benchmark::State& state, const std::string& input) {
   for (auto _ : state) {
     auto data = nlohmann::json::parse(input);
     benchmark::DoNotOptimize(data);
   }
+  set_bytes_processed(state, input);
 }
 
-BENCHMARK_F(json_bench, json_cpp_parse)(benchmark::State& state) {
+void run_json_cpp_parse(benchmark::State& state, const std::string& input) {
   for (auto _ : state) {
     Json::Reader reader;
     Json::Value obj;
     reader.parse(input, obj, false);
     benchmark::DoNotOptimize(obj);
   }
+  set_bytes_processed(state, input);
+}
+
+// -- decoding into C++ structs with a RapidJSON SAX handler -------------------
+
+// Decodes twitter.json into a twitter_result without building a DOM. Keeps a
+// stack of the objects and arrays we are currently in and skips everything
+// that has no counterpart in our types.
+class twitter_handler
+  : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, twitter_handler> {
+public:
+  explicit twitter_handler(twitter_result& result) : result_(result) {
+    // nop
+  }
+
+  bool StartObject() {
+    if (stack_.empty())
+      return push(ctx::root);
+    switch (stack_.back()) {
+      case ctx::root:
+        return push(key_ == "search_metadata" ? ctx::search_metadata
+                                              : ctx::skip);
+      case ctx::statuses:
+        result_.statuses.emplace_back();
+        return push(ctx::status);
+      case ctx::status:
+        if (key_ == "metadata")
+          return push(ctx::metadata);
+        if (key_ == "user")
+          return push(ctx::user);
+        if (key_ == "entities")
+          return push(ctx::entities);
+        return push(ctx::skip);
+      case ctx::hashtags:
+        status().entities.hashtags.emplace_back();
+        return push(ctx::hashtag);
+      case ctx::user_mentions:
+        status().entities.user_mentions.emplace_back();
+        return push(ctx::user_mention);
+      default:
+        return push(ctx::skip);
+    }
+  }
+
+  bool EndObject(rapidjson::SizeType) {
+    return pop();
+  }
+
+  bool StartArray() {
+    if (stack_.empty())
+      return false;
+    switch (stack_.back()) {
+      case ctx::root:
+        return push(key_ == "statuses" ? ctx::statuses : ctx::skip);
+      case ctx::entities:
+        if (key_ == "hashtags")
+          return push(ctx::hashtags);
+        if (key_ == "user_mentions")
+          return push(ctx::user_mentions);
+        return push(ctx::skip);
+      case ctx::hashtag:
+      case ctx::user_mention:
+        return push(key_ == "indices" ? ctx::indices : ctx::skip);
+      default:
+        return push(ctx::skip);
+    }
+  }
+
+  bool EndArray(rapidjson::SizeType) {
+    return pop();
+  }
+
+  bool Key(const char* str, rapidjson::SizeType len, bool) {
+    // Note: the string is only valid during this call, so we need to copy it.
+    key_.assign(str, len);
+    return true;
+  }
+
+  bool String(const char* str, rapidjson::SizeType len, bool) {
+    std::string_view val{str, len};
+    switch (stack_.back()) {
+      case ctx::metadata: {
+        auto& x = status().metadata;
+        assign(x.result_type, "result_type", val)
+          || assign(x.iso_language_code, "iso_language_code", val);
+        break;
+      }
+      case ctx::status: {
+        auto& x = status();
+        assign(x.created_at, "created_at", val)
+          || assign(x.id_str, "id_str", val) || assign(x.text, "text", val)
+          || assign(x.source, "source", val)
+          || assign(x.in_reply_to_screen_name, "in_reply_to_screen_name", val)
+          || assign(x.lang, "lang", val);
+        break;
+      }
+      case ctx::user: {
+        auto& x = status().user;
+        assign(x.id_str, "id_str", val) || assign(x.name, "name", val)
+          || assign(x.screen_name, "screen_name", val)
+          || assign(x.location, "location", val)
+          || assign(x.description, "description", val)
+          || assign(x.url, "url", val)
+          || assign(x.created_at, "created_at", val)
+          || assign(x.lang, "lang", val);
+        break;
+      }
+      case ctx::hashtag:
+        assign(status().entities.hashtags.back().text, "text", val);
+        break;
+      case ctx::user_mention: {
+        auto& x = status().entities.user_mentions.back();
+        assign(x.screen_name, "screen_name", val)
+          || assign(x.name, "name", val) || assign(x.id_str, "id_str", val);
+        break;
+      }
+      case ctx::search_metadata: {
+        auto& x = result_.search_metadata;
+        assign(x.max_id_str, "max_id_str", val)
+          || assign(x.next_results, "next_results", val)
+          || assign(x.query, "query", val)
+          || assign(x.refresh_url, "refresh_url", val)
+          || assign(x.since_id_str, "since_id_str", val);
+        break;
+      }
+      default:
+        break;
+    }
+    return true;
+  }
+
+  bool Int(int val) {
+    return Int64(val);
+  }
+
+  bool Uint(unsigned val) {
+    return Int64(val);
+  }
+
+  bool Uint64(uint64_t val) {
+    return Int64(static_cast<int64_t>(val));
+  }
+
+  bool Int64(int64_t val) {
+    switch (stack_.back()) {
+      case ctx::status: {
+        auto& x = status();
+        assign(x.id, "id", val)
+          || assign(x.in_reply_to_status_id, "in_reply_to_status_id", val)
+          || assign(x.retweet_count, "retweet_count", val)
+          || assign(x.favorite_count, "favorite_count", val);
+        break;
+      }
+      case ctx::user: {
+        auto& x = status().user;
+        assign(x.id, "id", val)
+          || assign(x.followers_count, "followers_count", val)
+          || assign(x.friends_count, "friends_count", val)
+          || assign(x.listed_count, "listed_count", val)
+          || assign(x.favourites_count, "favourites_count", val)
+          || assign(x.statuses_count, "statuses_count", val);
+        break;
+      }
+      case ctx::user_mention:
+        assign(status().entities.user_mentions.back().id, "id", val);
+        break;
+      case ctx::indices: {
+        auto parent = stack_[stack_.size() - 2];
+        auto& entities = status().entities;
+        auto& indices = parent == ctx::hashtag
+                          ? entities.hashtags.back().indices
+                          : entities.user_mentions.back().indices;
+        indices.push_back(static_cast<int32_t>(val));
+        break;
+      }
+      case ctx::search_metadata: {
+        auto& x = result_.search_metadata;
+        assign(x.max_id, "max_id", val) || assign(x.count, "count", val)
+          || assign(x.since_id, "since_id", val);
+        break;
+      }
+      default:
+        break;
+    }
+    return true;
+  }
+
+  bool Double(double val) {
+    if (stack_.back() == ctx::search_metadata)
+      assign(result_.search_metadata.completed_in, "completed_in", val);
+    return true;
+  }
+
+  bool Bool(bool val) {
+    switch (stack_.back()) {
+      case ctx::status: {
+        auto& x = status();
+        assign(x.truncated, "truncated", val)
+          || assign(x.favorited, "favorited", val)
+          || assign(x.retweeted, "retweeted", val);
+        break;
+      }
+      case ctx::user: {
+        auto& x = status().user;
+        assign(x.is_protected, "protected", val)
+          || assign(x.verified, "verified", val);
+        break;
+      }
+      default:
+        break;
+    }
+    return true;
+  }
+
+  bool Null() {
+    switch (stack_.back()) {
+      case ctx::status: {
+        auto& x = status();
+        if (key_ == "in_reply_to_status_id")
+          x.in_reply_to_status_id.reset();
+        else if (key_ == "in_reply_to_screen_name")
+          x.in_reply_to_screen_name.reset();
+        break;
+      }
+      case ctx::user:
+        if (key_ == "url")
+          status().user.url.reset();
+        break;
+      default:
+        break;
+    }
+    return true;
+  }
+
+private:
+  enum class ctx {
+    root,
+    statuses,
+    status,
+    metadata,
+    user,
+    entities,
+    hashtags,
+    hashtag,
+    user_mentions,
+    user_mention,
+    indices,
+    search_metadata,
+    skip,
+  };
+
+  bool push(ctx x) {
+    stack_.push_back(x);
+    return true;
+  }
+
+  bool pop() {
+    stack_.pop_back();
+    return true;
+  }
+
+  twitter_status& status() {
+    return result_.statuses.back();
+  }
+
+  template <class T, class U>
+  bool assign(T& x, std::string_view key, const U& val) {
+    if (key_ != key)
+      return false;
+    x = T(val);
+    return true;
+  }
+
+  twitter_result& result_;
+  std::vector<ctx> stack_;
+  std::string key_;
+};
+
+// -- typed decoding of twitter.json -------------------------------------------
+
+void check_decoded(benchmark::State& state, const twitter_result& result) {
+  if (result.statuses.size() != 100 || result.search_metadata.count != 100)
+    state.SkipWithError("decoded an unexpected result");
+}
+
+void run_caf_decode(benchmark::State& state, const std::string& input) {
+  for (auto _ : state) {
+    twitter_result result;
+    caf::json_reader reader;
+    if (!reader.load(input) || !reader.apply(result)) {
+      state.SkipWithError("caf::json_reader failed to decode the input");
+      break;
+    }
+    benchmark::DoNotOptimize(result);
+    check_decoded(state, result);
+  }
+  set_bytes_processed(state, input);
+}
+
+void run_rapidjson_decode(benchmark::State& state, const std::string& input) {
+  for (auto _ : state) {
+    twitter_result result;
+    twitter_handler handler{result};
+    rapidjson::Reader reader;
+    rapidjson::StringStream stream{input.c_str()};
+    if (!reader.Parse(stream, handler)) {
+      state.SkipWithError("RapidJSON failed to decode the input");
+      break;
+    }
+    benchmark::DoNotOptimize(result);
+    check_decoded(state, result);
+  }
+  set_bytes_processed(state, input);
+}
+
+void run_nlohmann_decode(benchmark::State& state, const std::string& input) {
+  for (auto _ : state) {
+    auto result = nlohmann::json::parse(input).get<twitter_result>();
+    benchmark::DoNotOptimize(result);
+    check_decoded(state, result);
+  }
+  set_bytes_processed(state, input);
+}
+
+// -- deterministic generators for the nativejson-benchmark shapes -------------
+
+void append_double(std::string& out, double x) {
+  char buf[32];
+  auto n = snprintf(buf, sizeof(buf), "%.15f", x);
+  out.append(buf, static_cast<size_t>(n));
+}
+
+// Maps the next output of `rng` to [lo, hi]. Unlike the standard distributions,
+// which are implementation-defined, this produces the same sequence with every
+// standard library.
+int64_t next_int(std::minstd_rand& rng, int64_t lo, int64_t hi) {
+  auto range = static_cast<uint64_t>(hi - lo) + 1;
+  return lo + static_cast<int64_t>(rng() % range);
+}
+
+// Maps the next output of `rng` to [lo, hi] (see next_int).
+double next_double(std::minstd_rand& rng, double lo, double hi) {
+  constexpr auto min = std::minstd_rand::min();
+  constexpr auto max = std::minstd_rand::max();
+  auto x = static_cast<double>(rng() - min) / static_cast<double>(max - min);
+  return lo + x * (hi - lo);
+}
+
+// Generates a GeoJSON feature collection similar to canada.json, i.e., almost
+// all of the input consists of floating point coordinates.
+std::string make_canada_like(size_t min_size) {
+  constexpr size_t max_points_per_ring = 1024;
+  std::minstd_rand rng{0xCAF};
+  std::string out = R"({"type":"FeatureCollection","features":[)";
+  for (size_t feature = 0; out.size() < min_size; ++feature) {
+    if (feature > 0)
+      out += ',';
+    out += R"({"type":"Feature","properties":{"name":"Feature )";
+    out += std::to_string(feature);
+    out += R"("},"geometry":{"type":"Polygon","coordinates":[[)";
+    for (size_t i = 0; i < max_points_per_ring && out.size() < min_size; ++i) {
+      if (i > 0)
+        out += ',';
+      out += '[';
+      append_double(out, next_double(rng, -141.0, -52.0));
+      out += ',';
+      append_double(out, next_double(rng, 41.0, 83.0));
+      out += ']';
+    }
+    out += "]]}}";
+  }
+  out += "]}";
+  return out;
+}
+
+// Generates a ticket catalog similar to citm_catalog.json, i.e., deeply nested
+// objects and arrays with integers, nulls and short strings.
+std::string make_citm_like(size_t min_size) {
+  std::minstd_rand rng{0xCAF};
+  auto id = [&rng] { return next_int(rng, 100'000'000, 999'999'999); };
+  auto count = [&rng] { return static_cast<int>(next_int(rng, 1, 4)); };
+  auto amount = [&rng] { return next_int(rng, 10'000, 100'000); };
+  auto append_ids = [&](std::string& out, int n) {
+    out += '[';
+    for (int i = 0; i < n; ++i) {
+      if (i > 0)
+        out += ',';
+      out += std::to_string(id());
+    }
+    out += ']';
+  };
+  std::string events;
+  std::string performances;
+  for (size_t i = 0; events.size() + performances.size() < min_size; ++i) {
+    auto event_id = std::to_string(id());
+    if (i > 0) {
+      events += ',';
+      performances += ',';
+    }
+    events += '"';
+    events += event_id;
+    events += R"(":{"description":null,"id":)";
+    events += event_id;
+    events += R"(,"logo":null,"name":"Event )";
+    events += std::to_string(i);
+    events += R"(","subTopicIds":)";
+    append_ids(events, count());
+    events += R"(,"subjectCode":null,"subtitle":null,"topicIds":)";
+    append_ids(events, count());
+    events += '}';
+    performances += R"({"eventId":)";
+    performances += event_id;
+    performances += R"(,"id":)";
+    performances += std::to_string(id());
+    performances += R"(,"logo":null,"name":null,"prices":[)";
+    auto num_categories = count();
+    for (int j = 0; j < num_categories; ++j) {
+      if (j > 0)
+        performances += ',';
+      performances += R"({"amount":)";
+      performances += std::to_string(amount());
+      performances += R"(,"audienceSubCategoryId":)";
+      performances += std::to_string(id());
+      performances += R"(,"seatCategoryId":)";
+      performances += std::to_string(id());
+      performances += '}';
+    }
+    performances += R"(],"seatCategories":[)";
+    for (int j = 0; j < num_categories; ++j) {
+      if (j > 0)
+        performances += ',';
+      performances += R"({"areas":[)";
+      auto num_areas = count();
+      for (int k = 0; k < num_areas; ++k) {
+        if (k > 0)
+          performances += ',';
+        performances += R"({"areaId":)";
+        performances += std::to_string(id());
+        performances += R"(,"blockIds":[]})";
+      }
+      performances += R"(],"seatCategoryId":)";
+      performances += std::to_string(id());
+      performances += '}';
+    }
+    performances += R"(],"seatMapImage":null,"start":)";
+    performances += std::to_string(1'372'701'600'000 + i * 3'600'000);
+    performances += R"(,"venueCode":"PLEYEL_PLEYEL"})";
+  }
+  std::string out = R"({"areaNames":{"205705993":"Arrière-scène",)"
+                    R"("205705994":"1er balcon central"},"events":{)";
+  out += events;
+  out += R"(},"performances":[)";
+  out += performances;
+  out += "]}";
+  return out;
+}
+
+// Passes the minimum input size in KiB as first argument.
+void json_sizes(benchmark::internal::Benchmark* bench) {
+  bench->Arg(16)->Arg(1024)->Arg(4 * 1024)->ArgName("kib");
+}
+
+// Like json_sizes, but for the opt-in inputs in the hundreds of MB. Parsing
+// these requires a few GiB of memory for the DOM representations.
+void json_large_sizes(benchmark::internal::Benchmark* bench) {
+  bench->Arg(64 * 1024)->Arg(256 * 1024)->ArgName("kib");
+}
+
+} // namespace
+
+// -- benchmarks for data/twitter.json -----------------------------------------
+
+class json_bench : public base_fixture {
+public:
+  std::string input;
+
+  void SetUp(const benchmark::State&) override {
+    std::ifstream t{twitter_json_file};
+    if (!t) {
+      fprintf(stderr, "failed to load %s\n", twitter_json_file);
+      abort();
+    }
+    std::stringstream buffer;
+    buffer << t.rdbuf();
+    input = buffer.str();
+  }
+};
+
+BENCHMARK_F(json_bench, caf_parse)(benchmark::State& state) {
+  run_caf_parse(state, input);
+}
+
+BENCHMARK_F(json_bench, rapidjson_parse)(benchmark::State& state) {
+  run_rapidjson_parse(state, input);
+}
+
+BENCHMARK_F(json_bench, nlohmann_parse)(benchmark::State& state) {
+  run_nlohmann_parse(state, input);
+}
+
+BENCHMARK_F(json_bench, json_cpp_parse)(benchmark::State& state) {
+  run_json_cpp_parse(state, input);
+}
+
+// Parses the input and then decodes it into twitter_result.
+BENCHMARK_F(json_bench, caf_decode)(benchmark::State& state) {
+  run_caf_decode(state, input);
+}
+
+// Uses a SAX handler that decodes into twitter_result without any DOM.
+BENCHMARK_F(json_bench, rapidjson_decode)(benchmark::State& state) {
+  run_rapidjson_decode(state, input);
+}
+
+// Parses the input and then decodes it into twitter_result via from_json.
+BENCHMARK_F(json_bench, nlohmann_decode)(benchmark::State& state) {
+  run_nlohmann_decode(state, input);
+}
+
+// -- benchmarks for generated number-heavy input (canada.json) ----------------
+
+class json_canada : public base_fixture {
+public:
+  std::string input;
+
+  void SetUp(const benchmark::State& state) override {
+    input = make_canada_like(static_cast<size_t>(state.range(0)) * 1024);
+  }
+
+  void TearDown(const ::benchmark::State&) override {
+    input = std::string{};
+  }
+};
+
+BENCHMARK_DEFINE_F(json_canada, caf_parse)(benchmark::State& state) {
+  run_caf_parse(state, input);
+}
+
+BENCHMARK_REGISTER_F(json_canada, caf_parse)->Apply(json_sizes);
+
+BENCHMARK_DEFINE_F(json_canada, rapidjson_parse)(benchmark::State& state) {
+  run_rapidjson_parse(state, input);
+}
+
+BENCHMARK_REGISTER_F(json_canada, rapidjson_parse)->Apply(json_sizes);
+
+BENCHMARK_DEFINE_F(json_canada, nlohmann_parse)(benchmark::State& state) {
+  run_nlohmann_parse(state, input);
+}
+
+BENCHMARK_REGISTER_F(json_canada, nlohmann_parse)->Apply(json_sizes);
+
+BENCHMARK_DEFINE_F(json_canada, json_cpp_parse)(benchmark::State& state) {
+  run_json_cpp_parse(state, input);
+}
+
+BENCHMARK_REGISTER_F(json_canada, json_cpp_parse)->Apply(json_sizes);
+
+// -- benchmarks for generated deeply structured input (citm_catalog.json) -----
+
+class json_citm : public base_fixture {
+public:
+  std::string input;
+
+  void SetUp(const benchmark::State& state) override {
+    input = make_citm_like(static_cast<size_t>(state.range(0)) * 1024);
+  }
+
+  void TearDown(const ::benchmark::State&) override {
+    input = std::string{};
+  }
+};
+
+BENCHMARK_DEFINE_F(json_citm, caf_parse)(benchmark::State& state) {
+  run_caf_parse(state, input);
+}
+
+BENCHMARK_REGISTER_F(json_citm, caf_parse)->Apply(json_sizes);
+
+BENCHMARK_DEFINE_F(json_citm, rapidjson_parse)(benchmark::State& state) {
+  run_rapidjson_parse(state, input);
+}
+
+BENCHMARK_REGISTER_F(json_citm, rapidjson_parse)->Apply(json_sizes);
+
+BENCHMARK_DEFINE_F(json_citm, nlohmann_parse)(benchmark::State& state) {
+  run_nlohmann_parse(state, input);
+}
+
+BENCHMARK_REGISTER_F(json_citm, nlohmann_parse)->Apply(json_sizes);
+
+BENCHMARK_DEFINE_F(json_citm, json_cpp_parse)(benchmark::State& state) {
+  run_json_cpp_parse(state, input);
+}
+
+BENCHMARK_REGISTER_F(json_citm, json_cpp_parse)->Apply(json_sizes);
+
+// -- opt-in benchmarks for inputs in the hundreds of MB -----------------------
+
+namespace {
+
+using run_fn = void (*)(benchmark::State&, const std::string&);
+
+// Runs `run` on the input of `Fixture`. Equivalent to the classes that
+// BENCHMARK_DEFINE_F generates, but with a name and function at runtime.
+template <class Fixture>
+class large_json_benchmark : public Fixture {
+public:
+  large_json_benchmark(const std::string& name, run_fn run) : run_(run) {
+    this->SetName(name.c_str());
+  }
+
+protected:
+  void BenchmarkCase(benchmark::State& state) override {
+    run_(state, this->input);
+  }
+
+private:
+  run_fn run_;
+};
+
+// Registers all parsers for the input of `Fixture` under `prefix`.
+template <class Fixture>
+void register_large_json_parsers(const std::string& prefix) {
+  std::pair<const char*, run_fn> parsers[] = {
+    {"caf_parse", run_caf_parse},
+    {"rapidjson_parse", run_rapidjson_parse},
+    {"nlohmann_parse", run_nlohmann_parse},
+    {"json_cpp_parse", run_json_cpp_parse},
+  };
+  for (auto [name, run] : parsers) {
+    auto bench = new large_json_benchmark<Fixture>(prefix + name, run);
+    benchmark::internal::RegisterBenchmarkInternal(bench)->Apply(
+      json_large_sizes);
+  }
+}
+
+} // namespace
+
+void register_large_json_benchmarks() {
+  register_large_json_parsers<json_canada>("json_canada_large/");
+  register_large_json_parsers<json_citm>("json_citm_large/");
 }
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#ifdef _MSC_VER
+#  include <intrin.h>
+#endif
+
+// Directory for dumping full histograms, set via --latency_dump_dir on the
+// command line. Dumping is disabled if empty.
+extern std::string latency_dump_dir;
+
+// Records latencies in nanoseconds with a fixed memory footprint, similar to
+// an HDR histogram. Values below 128ns are stored exactly. Larger values fall
+// into one of 64 linear sub-buckets per power of two, i.e., each recorded
+// value has a relative error below 1/64. Recording never allocates.
+class latency_histogram {
+public:
+  using clock_type = std::chrono::steady_clock;
+
+  static constexpr int sub_bucket_bits = 6;
+
+  static constexpr uint64_t sub_bucket_half = uint64_t{1} << sub_bucket_bits;
+
+  // Values with more than max_bits bits (about 78 hours) get clamped.
+  static constexpr int max_bits = 48;
+
+  static constexpr size_t num_buckets
+    = (max_bits - sub_bucket_bits) * sub_bucket_half + 2 * sub_bucket_half;
+
+  latency_histogram() {
+    reset();
+  }
+
+  void reset() noexcept {
+    counts_.fill(0);
+    total_ = 0;
+    max_ = 0;
+  }
+
+  void record(uint64_t ns) noexcept {
+    ns = std::min(ns, (uint64_t{1} << max_bits) - 1);
+    ++counts_[index_of(ns)];
+    ++total_;
+    max_ = std::max(max_, ns);
+  }
+
+  template <class Rep, class Period>
+  void record(std::chrono::duration<Rep, Period> x) noexcept {
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+    record(static_cast<uint64_t>(duration_cast<nanoseconds>(x).count()));
+  }
+
+  void record_since(clock_type::time_point t0) noexcept {
+    record(clock_type::now() - t0);
+  }
+
+  uint64_t count() const noexcept {
+    return total_;
+  }
+
+  uint64_t max() const noexcept {
+    return max_;
+  }
+
+  // Returns the highest value that is equivalent to the value at percentile
+  // `p` (0 < p <= 100).
+  uint64_t percentile(double p) const noexcept {
+    if (total_ == 0)
+      return 0;
+    // Same rank computation as HdrHistogram, i.e., round up to the next sample.
+    auto fractional_rank = p / 100.0 * static_cast<double>(total_);
+    auto rank = static_cast<uint64_t>(std::ceil(fractional_rank));
+    rank = std::clamp(rank, uint64_t{1}, total_);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < num_buckets; ++i) {
+      seen += counts_[i];
+      if (seen >= rank)
+        return std::min(highest_equivalent_value(i), max_);
+    }
+    return max_;
+  }
+
+  // Adds p50, p90, p99, p99.9 and max (in ns) as user counters and dumps the
+  // full histogram to `<latency_dump_dir>/<name>.hgrm` if enabled.
+  void report(benchmark::State& state, const std::string& name) const {
+    state.counters["p50_ns"] = static_cast<double>(percentile(50.0));
+    state.counters["p90_ns"] = static_cast<double>(percentile(90.0));
+    state.counters["p99_ns"] = static_cast<double>(percentile(99.0));
+    state.counters["p99.9_ns"] = static_cast<double>(percentile(99.9));
+    state.counters["max_ns"] = static_cast<double>(max_);
+    if (!latency_dump_dir.empty())
+      dump(latency_dump_dir + '/' + file_name(name) + ".hgrm");
+  }
+
+  // Writes all non-empty buckets with their cumulative percentile.
+  bool dump(const std::string& path) const {
+    auto fp = fopen(path.c_str(), "w");
+    if (fp == nullptr)
+      return false;
+    fprintf(fp, "%16s %12s %16s\n", "value_ns", "percentile", "total_count");
+    uint64_t seen = 0;
+    for (size_t i = 0; i < num_buckets; ++i) {
+      if (counts_[i] == 0)
+        continue;
+      seen += counts_[i];
+      auto pct = 100.0 * static_cast<double>(seen)
+                 / static_cast<double>(total_);
+      fprintf(fp, "%16llu %12.6f %16llu\n",
+              static_cast<unsigned long long>(highest_equivalent_value(i)), pct,
+              static_cast<unsigned long long>(seen));
+    }
+    fprintf(fp, "#[max = %llu, count = %llu]\n",
+            static_cast<unsigned long long>(max_),
+            static_cast<unsigned long long>(total_));
+    fclose(fp);
+    return true;
+  }
+
+private:
+  static size_t index_of(uint64_t ns) noexcept {
+    if (ns < 2 * sub_bucket_half)
+      return static_cast<size_t>(ns);
+#ifdef _MSC_VER
+    unsigned long msb;
+    _BitScanReverse64(&msb, ns);
+#else
+    auto msb = 63 - __builtin_clzll(ns);
+#endif
+    auto shift = static_cast<int>(msb) - sub_bucket_bits;
+    return static_cast<size_t>(shift) * sub_bucket_half + (ns >> shift);
+  }
+
+  static uint64_t highest_equivalent_value(size_t index) noexcept {
+    if (index < 2 * sub_bucket_half)
+      return index;
+    auto shift = index / sub_bucket_half - 1;
+    auto sub_bucket = index - shift * sub_bucket_half;
+    return ((sub_bucket + 1) << shift) - 1;
+  }
+
+  static std::string file_name(std::string name) {
+    std::replace_if(
+      name.begin(), name.end(),
+      [](char c) { return c == '/' || c == ':' || c == '<' || c == '>'; },
+      '_');
+    return name;
+  }
+
+  std::array<uint64_t, num_buckets> counts_;
+  uint64_t total_;
+  uint64_t max_;
+};
@@ -1,6 +1,424 @@
 #include "main.hpp"
 
-caf_context::caf_context() : sys(cfg) {
+#include "barrier.hpp"
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if CAF_VERSION < 1800
+#  include "caf/atom.hpp"
+#endif
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+#if defined(__APPLE__)
+#  include <malloc/malloc.h>
+#else
+#  include <malloc.h>
+#endif
+
+scheduler_config default_scheduler_config;
+
+std::string latency_dump_dir;
+
+barrier_mode default_barrier_mode = barrier_mode::blocking;
+
+bool count_allocations = false;
+
+bool json_large_inputs = false;
+
+bool use_perf_counters = false;
+
+namespace {
+
+// -- state for the counting operator new/delete -------------------------------
+
+std::atomic<bool> recording_allocations;
+
+std::atomic<uint64_t> num_allocations;
+
+std::atomic<uint64_t> allocated_bytes;
+
+// Bytes allocated minus bytes released since the last reset. May become
+// negative when releasing memory that was allocated before.
+std::atomic<int64_t> live_bytes;
+
+std::atomic<int64_t> peak_live_bytes;
+
+// Returns the number of bytes the allocator reserved for `ptr`, which may be
+// larger than the requested size.
+size_t usable_size(void* ptr) noexcept {
+#if defined(__APPLE__)
+  return malloc_size(ptr);
+#elif defined(_MSC_VER)
+  return _msize(ptr);
+#else
+  return malloc_usable_size(ptr);
+#endif
+}
+
+void on_allocate(void* ptr) noexcept {
+  auto size = static_cast<int64_t>(usable_size(ptr));
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(static_cast<uint64_t>(size),
+                            std::memory_order_relaxed);
+  auto live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+  auto peak = peak_live_bytes.load(std::memory_order_relaxed);
+  while (live > peak
+         && !peak_live_bytes.compare_exchange_weak(peak, live,
+                                                   std::memory_order_relaxed)) {
+    // nop
+  }
+}
+
+void on_deallocate(void* ptr) noexcept {
+  auto size = static_cast<int64_t>(usable_size(ptr));
+  live_bytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+caf::actor_system_config& configure(caf::actor_system_config& cfg,
+                                    const scheduler_config& sched) {
+#if CAF_VERSION >= 1800
+  constexpr auto max_threads_key = "caf.scheduler.max-threads";
+  constexpr auto policy_key = "caf.scheduler.policy";
+#else
+  constexpr auto max_threads_key = "scheduler.max-threads";
+  constexpr auto policy_key = "scheduler.policy";
+#endif
+  if (sched.num_workers > 0)
+    cfg.set(max_threads_key, static_cast<int64_t>(sched.num_workers));
+  auto sharing = sched.policy == scheduler_policy::sharing;
+#if CAF_VERSION >= 1800
+  cfg.set(policy_key, sharing ? "sharing" : "stealing");
+#else
+  // CAF 0.17 reads the policy as atom and ignores strings.
+  cfg.set(policy_key, sharing ? caf::atom("sharing") : caf::atom("stealing"));
+#endif
+  return cfg;
+}
+
+// -- state for the hardware performance counters ------------------------------
+
+struct perf_counter {
+  const char* name;
+  uint32_t type;
+  uint64_t config;
+  int fd;
+  double value;
+};
+
+// Non-empty only while the counters are running. Uses fixed storage to keep
+// the counters from showing up in the allocation statistics.
+std::array<perf_counter, 8> perf_events;
+
+size_t num_perf_events;
+
+#ifdef __linux__
+
+constexpr uint64_t perf_cache_event(uint64_t id, uint64_t op, uint64_t result) {
+  return id | (op << 8) | (result << 16);
+}
+
+constexpr perf_counter hardware_counters[] = {
+  {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1, 0},
+  {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, -1, 0},
+  {"L1D_misses", PERF_TYPE_HW_CACHE,
+   perf_cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                    PERF_COUNT_HW_CACHE_RESULT_MISS),
+   -1, 0},
+  {"LLC_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, -1, 0},
+  {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, -1, 0},
+};
+
+constexpr perf_counter software_counters[] = {
+  {"task_clock_ns", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, -1, 0},
+  {"context_switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, -1,
+   0},
+  {"page_faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, -1, 0},
+};
+
+// Opens a disabled counter for the calling thread and all threads it spawns
+// afterwards. Excluding the kernel allows unprivileged access in the default
+// configuration (perf_event_paranoid = 2).
+int open_perf_event(uint32_t type, uint64_t config) {
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+                     | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+template <size_t N>
+void open_perf_events(const perf_counter (&counters)[N]) {
+  for (auto ev : counters) {
+    ev.fd = open_perf_event(ev.type, ev.config);
+    if (ev.fd >= 0)
+      perf_events[num_perf_events++] = ev;
+  }
+}
+
+#endif
+
+// Parses `--name`, `--name=true` or `--name=false`. Returns whether `arg`
+// matched `name`.
+bool parse_bool_flag(const char* arg, const char* name, bool& value) {
+  auto len = strlen(name);
+  if (strncmp(arg, name, len) != 0)
+    return false;
+  auto val = arg + len;
+  if (*val == '\0' || strcmp(val, "=true") == 0) {
+    value = true;
+  } else if (strcmp(val, "=false") == 0) {
+    value = false;
+  } else if (*val == '=') {
+    fprintf(stderr, "invalid argument: %s\n", arg);
+    exit(EXIT_FAILURE);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Removes our own flags from argv before passing it to Google Benchmark.
+void parse_custom_flags(int& argc, char** argv) {
+  constexpr auto workers_flag = "--caf_workers=";
+  constexpr auto policy_flag = "--caf_policy=";
+  constexpr auto dump_flag = "--latency_dump_dir=";
+  constexpr auto barrier_flag = "--barrier=";
+  constexpr auto allocs_flag = "--count_allocations";
+  constexpr auto json_large_flag = "--json_large_inputs";
+  constexpr auto perf_flag = "--perf_counters";
+  auto out = 1;
+  for (auto i = 1; i < argc; ++i) {
+    auto arg = argv[i];
+    if (strncmp(arg, workers_flag, strlen(workers_flag)) == 0) {
+      auto val = arg + strlen(workers_flag);
+      char* end = nullptr;
+      errno = 0;
+      auto num = strtoul(val, &end, 10);
+      if (!isdigit(static_cast<unsigned char>(*val)) || *end != '\0'
+          || errno != 0 || num == 0) {
+        fprintf(stderr, "invalid number of workers: %s\n", val);
+        exit(EXIT_FAILURE);
+      }
+      default_scheduler_config.num_workers = num;
+    } else if (strncmp(arg, policy_flag, strlen(policy_flag)) == 0) {
+      auto val = arg + strlen(policy_flag);
+      if (strcmp(val, "stealing") == 0) {
+        default_scheduler_config.policy = scheduler_policy::stealing;
+      } else if (strcmp(val, "sharing") == 0) {
+        default_scheduler_config.policy = scheduler_policy::sharing;
+      } else {
+        fprintf(stderr, "invalid scheduler policy: %s\n", val);
+        exit(EXIT_FAILURE);
+      }
+    } else if (strncmp(arg, dump_flag, strlen(dump_flag)) == 0) {
+      latency_dump_dir = arg + strlen(dump_flag);
+    } else if (strncmp(arg, barrier_flag, strlen(barrier_flag)) == 0) {
+      auto val = arg + strlen(barrier_flag);
+      if (strcmp(val, "blocking") == 0) {
+        default_barrier_mode = barrier_mode::blocking;
+      } else if (strcmp(val, "spinning") == 0) {
+        default_barrier_mode = barrier_mode::spinning;
+      } else {
+        fprintf(stderr, "invalid barrier mode: %s\n", val);
+        exit(EXIT_FAILURE);
+      }
+    } else if (parse_bool_flag(arg, allocs_flag, count_allocations)) {
+      // nop
+    } else if (parse_bool_flag(arg, json_large_flag, json_large_inputs)) {
+      // nop
+    } else if (parse_bool_flag(arg, perf_flag, use_perf_counters)) {
+      // nop
+    } else {
+      argv[out++] = arg;
+    }
+  }
+  argc = out;
+}
+
+} // namespace
+
+// -- counting operator new/delete ---------------------------------------------
+
+void* operator new(size_t size) {
+  if (size == 0)
+    size = 1;
+  for (;;) {
+    if (auto ptr = malloc(size)) {
+      if (recording_allocations.load(std::memory_order_relaxed))
+        on_allocate(ptr);
+      return ptr;
+    }
+    auto handler = std::get_new_handler();
+    if (handler == nullptr)
+      throw std::bad_alloc{};
+    handler();
+  }
+}
+
+// GCC falsely reports a mismatch when inlining free() after operator new.
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* ptr) noexcept {
+  if (ptr == nullptr)
+    return;
+  if (recording_allocations.load(std::memory_order_relaxed))
+    on_deallocate(ptr);
+  free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic pop
+#endif
+
+void operator delete(void* ptr, size_t) noexcept {
+  operator delete(ptr);
+}
+
+void start_allocation_counting() {
+  num_allocations = 0;
+  allocated_bytes = 0;
+  live_bytes = 0;
+  peak_live_bytes = 0;
+  recording_allocations = true;
+}
+
+void stop_allocation_counting(benchmark::State& state) {
+  recording_allocations = false;
+  auto iterations = static_cast<double>(std::max<benchmark::IterationCount>(
+    state.iterations(), 1));
+  state.counters["allocs_per_iter"]
+    = static_cast<double>(num_allocations.load()) / iterations;
+  state.counters["bytes_per_iter"]
+    = static_cast<double>(allocated_bytes.load()) / iterations;
+  state.counters["peak_live_bytes"]
+    = static_cast<double>(peak_live_bytes.load());
+}
+
+// -- memory usage -------------------------------------------------------------
+
+size_t resident_memory() {
+#ifdef __linux__
+  auto fp = fopen("/proc/self/statm", "r");
+  if (fp == nullptr)
+    return 0;
+  unsigned long total = 0;
+  unsigned long resident = 0;
+  auto res = fscanf(fp, "%lu %lu", &total, &resident);
+  fclose(fp);
+  if (res != 2)
+    return 0;
+  return static_cast<size_t>(resident)
+         * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+  return 0;
+#endif
+}
+
+// -- hardware performance counters --------------------------------------------
+
+void open_perf_counters() {
+#ifdef __linux__
+  static bool warned = false;
+  num_perf_events = 0;
+  open_perf_events(hardware_counters);
+  if (num_perf_events == 0) {
+    if (!warned)
+      fprintf(stderr,
+              "*** hardware performance counters unavailable (%s), "
+              "falling back to software counters\n",
+              strerror(errno));
+    open_perf_events(software_counters);
+  }
+  if (num_perf_events == 0 && !warned)
+    fprintf(stderr, "*** software performance counters unavailable (%s)\n",
+            strerror(errno));
+  warned = true;
+#else
+  static bool warned = false;
+  if (!warned) {
+    fprintf(stderr, "*** performance counters require Linux\n");
+    warned = true;
+  }
+#endif
+}
+
+void start_perf_counters() {
+#ifdef __linux__
+  // Both operations also apply to the counters that threads inherited.
+  for (size_t i = 0; i < num_perf_events; ++i) {
+    ioctl(perf_events[i].fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(perf_events[i].fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+#endif
+}
+
+void stop_perf_counters() {
+#ifdef __linux__
+  for (size_t i = 0; i < num_perf_events; ++i)
+    ioctl(perf_events[i].fd, PERF_EVENT_IOC_DISABLE, 0);
+  for (size_t i = 0; i < num_perf_events; ++i) {
+    auto& ev = perf_events[i];
+    // Layout for PERF_FORMAT_TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING.
+    uint64_t buf[3] = {0, 0, 0};
+    ev.value = 0;
+    if (read(ev.fd, buf, sizeof(buf)) == sizeof(buf) && buf[2] > 0) {
+      // Scale up if the kernel had to multiplex the counters.
+      ev.value = static_cast<double>(buf[0]) * static_cast<double>(buf[1])
+                 / static_cast<double>(buf[2]);
+    }
+    close(ev.fd);
+  }
+#endif
+}
+
+void report_perf_counters(benchmark::State& state) {
+  double cycles = 0;
+  double instructions = 0;
+  for (size_t i = 0; i < num_perf_events; ++i) {
+    auto& ev = perf_events[i];
+    state.counters[ev.name] = benchmark::Counter(
+      ev.value, benchmark::Counter::kAvgIterations);
+    if (strcmp(ev.name, "cycles") == 0)
+      cycles = ev.value;
+    else if (strcmp(ev.name, "instructions") == 0)
+      instructions = ev.value;
+  }
+  if (cycles > 0 && instructions > 0)
+    state.counters["IPC"] = instructions / cycles;
+  num_perf_events = 0;
+}
+
+caf_context::caf_context() : caf_context(default_scheduler_config) {
+  // nop
+}
+
+caf_context::caf_context(const scheduler_config& sched)
+  : sys(configure(cfg, sched)) {
   // nop
 }
 
@@ -9,6 +427,9 @@ int main(int argc, char** argv) {
   caf::init_global_meta_objects<caf::id_block::microbench>();
   caf::core::init_global_meta_objects();
 #endif
+  parse_custom_flags(argc, argv);
+  if (json_large_inputs)
+    register_large_json_benchmarks();
   benchmark::Initialize(&argc, argv);
   if (benchmark::ReportUnrecognizedArguments(argc, argv))
     return 1;
@@ -1,10 +1,18 @@
+#pragma once
+
 #include "caf/actor_system.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/config.hpp"
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
 
 // -- utility functions --------------------------------------------------------
 
@@ -33,6 +41,118 @@ inline bool operator==(const bar& lhs, const bar& rhs) {
   return lhs.a == rhs.a && lhs.b == rhs.b;
 }
 
+// Counts how often CAF copies a payload, e.g., when detaching a message.
+struct counted_payload {
+  static inline std::atomic<size_t> copies{0};
+
+  std::vector<int> data;
+
+  counted_payload() = default;
+
+  explicit counted_payload(std::vector<int> xs) : data(std::move(xs)) {
+    // nop
+  }
+
+  counted_payload(counted_payload&&) = default;
+
+  counted_payload(const counted_payload& other) : data(other.data) {
+    ++copies;
+  }
+
+  counted_payload& operator=(counted_payload&&) = default;
+
+  counted_payload& operator=(const counted_payload& other) {
+    data = other.data;
+    ++copies;
+    return *this;
+  }
+};
+
+inline bool operator==(const counted_payload& lhs,
+                       const counted_payload& rhs) {
+  return lhs.data == rhs.data;
+}
+
+// -- types for decoding data/twitter.json (subset of the fields) --------------
+
+struct twitter_metadata {
+  std::string result_type;
+  std::string iso_language_code;
+};
+
+struct twitter_hashtag {
+  std::string text;
+  std::vector<int32_t> indices;
+};
+
+struct twitter_user_mention {
+  std::string screen_name;
+  std::string name;
+  int64_t id;
+  std::string id_str;
+  std::vector<int32_t> indices;
+};
+
+struct twitter_entities {
+  std::vector<twitter_hashtag> hashtags;
+  std::vector<twitter_user_mention> user_mentions;
+};
+
+struct twitter_user {
+  int64_t id;
+  std::string id_str;
+  std::string name;
+  std::string screen_name;
+  std::string location;
+  std::string description;
+  std::optional<std::string> url;
+  bool is_protected;
+  int64_t followers_count;
+  int64_t friends_count;
+  int64_t listed_count;
+  std::string created_at;
+  int64_t favourites_count;
+  bool verified;
+  int64_t statuses_count;
+  std::string lang;
+};
+
+struct twitter_status {
+  twitter_metadata metadata;
+  std::string created_at;
+  int64_t id;
+  std::string id_str;
+  std::string text;
+  std::string source;
+  bool truncated;
+  std::optional<int64_t> in_reply_to_status_id;
+  std::optional<std::string> in_reply_to_screen_name;
+  twitter_user user;
+  int64_t retweet_count;
+  int64_t favorite_count;
+  twitter_entities entities;
+  bool favorited;
+  bool retweeted;
+  std::string lang;
+};
+
+struct twitter_search_metadata {
+  double completed_in;
+  int64_t max_id;
+  std::string max_id_str;
+  std::string next_results;
+  std::string query;
+  std::string refresh_url;
+  int64_t count;
+  int64_t since_id;
+  std::string since_id_str;
+};
+
+struct twitter_result {
+  std::vector<twitter_status> statuses;
+  twitter_search_metadata search_metadata;
+};
+
 #if CAF_VERSION >= 1800
 
 #include "caf/init_global_meta_objects.hpp"
@@ -44,6 +164,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(microbench, caf::first_custom_type_id)
 #  if CAF_VERSION < 1900
   CAF_ADD_TYPE_ID(microbench, (caf::stream<int>) );
 #  endif
+  CAF_ADD_TYPE_ID(microbench, (counted_payload));
   CAF_ADD_TYPE_ID(microbench, (foo));
   CAF_ADD_TYPE_ID(microbench, (std::vector<int>));
 
@@ -59,6 +180,89 @@ bool inspect(Inspector& f, bar& x) {
   return f.object(x).fields(f.field("a", x.a), f.field("b", x.b));
 }
 
+template <typename Inspector>
+bool inspect(Inspector& f, counted_payload& x) {
+  return f.object(x).fields(f.field("data", x.data));
+}
+
+template <typename Inspector>
+bool inspect(Inspector& f, twitter_metadata& x) {
+  return f.object(x).fields(f.field("result_type", x.result_type),
+                            f.field("iso_language_code", x.iso_language_code));
+}
+
+template <typename Inspector>
+bool inspect(Inspector& f, twitter_hashtag& x) {
+  return f.object(x).fields(f.field("text", x.text),
+                            f.field("indices", x.indices));
+}
+
+template <typename Inspector>
+bool inspect(Inspector& f, twitter_user_mention& x) {
+  return f.object(x).fields(f.field("screen_name", x.screen_name),
+                            f.field("name", x.name), f.field("id", x.id),
+                            f.field("id_str", x.id_str),
+                            f.field("indices", x.indices));
+}
+
+template <typename Inspector>
+bool inspect(Inspector& f, twitter_entities& x) {
+  return f.object(x).fields(f.field("hashtags", x.hashtags),
+                            f.field("user_mentions", x.user_mentions));
+}
+
+template <typename Inspector>
+bool inspect(Inspector& f, twitter_user& x) {
+  return f.object(x).fields(f.field("id", x.id), f.field("id_str", x.id_str),
+                            f.field("name", x.name),
+                            f.field("screen_name", x.screen_name),
+                            f.field("location", x.location),
+                            f.field("description", x.description),
+                            f.field("url", x.url),
+                            f.field("protected", x.is_protected),
+                            f.field("followers_count", x.followers_count),
+                            f.field("friends_count", x.friends_count),
+                            f.field("listed_count", x.listed_count),
+                            f.field("created_at", x.created_at),
+                            f.field("favourites_count", x.favourites_count),
+                            f.field("verified", x.verified),
+                            f.field("statuses_count", x.statuses_count),
+                            f.field("lang", x.lang));
+}
+
+template <typename Inspector>
+bool inspect(Inspector& f, twitter_status& x) {
+  return f.object(x).fields(
+    f.field("metadata", x.metadata), f.field("created_at", x.created_at),
+    f.field("id", x.id), f.field("id_str", x.id_str), f.field("text", x.text),
+    f.field("source", x.source), f.field("truncated", x.truncated),
+    f.field("in_reply_to_status_id", x.in_reply_to_status_id),
+    f.field("in_reply_to_screen_name", x.in_reply_to_screen_name),
+    f.field("user", x.user), f.field("retweet_count", x.retweet_count),
+    f.field("favorite_count", x.favorite_count),
+    f.field("entities", x.entities), f.field("favorited", x.favorited),
+    f.field("retweeted", x.retweeted), f.field("lang", x.lang));
+}
+
+template <typename Inspector>
+bool inspect(Inspector& f, twitter_search_metadata& x) {
+  return f.object(x).fields(f.field("completed_in", x.completed_in),
+                            f.field("max_id", x.max_id),
+                            f.field("max_id_str", x.max_id_str),
+                            f.field("next_results", x.next_results),
+                            f.field("query", x.query),
+                            f.field("refresh_url", x.refresh_url),
+                            f.field("count", x.count),
+                            f.field("since_id", x.since_id),
+                            f.field("since_id_str", x.since_id_str));
+}
+
+template <typename Inspector>
+bool inspect(Inspector& f, twitter_result& x) {
+  return f.object(x).fields(f.field("statuses", x.statuses),
+                            f.field("search_metadata", x.search_metadata));
+}
+
 #  define APPLY_OR_DIE(inspector, what)                                        \
     if (!inspector.apply(what))                                                \
       CAF_CRITICAL("failed to apply data to the inspector!");
@@ -75,18 +279,59 @@ typename Inspector::result_type inspect(Inspector& f, bar& x) {
   return f(x.a, x.b);
 }
 
+template <typename Inspector>
+typename Inspector::result_type inspect(Inspector& f, counted_payload& x) {
+  return f(x.data);
+}
+
 #  define APPLY_OR_DIE(inspector, what)                                        \
     if (auto err = inspector(what))                                            \
       CAF_CRITICAL("failed to apply data to the inspector!");
 
 #endif // CAF_VERSION >= 1800
 
+// -- sample values for benchmarks that are generic over the payload type -----
+
+template <class T>
+T make_sample();
+
+template <>
+inline int32_t make_sample<int32_t>() {
+  return 42;
+}
+
+template <>
+inline foo make_sample<foo>() {
+  return foo{1, 2};
+}
+
+template <>
+inline bar make_sample<bar>() {
+  return bar{foo{1, 2}, "three"};
+}
+
 // -- fixture base for initializing global meta objects ------------------------
 
+enum class scheduler_policy {
+  stealing,
+  sharing,
+};
+
+struct scheduler_config {
+  // Number of scheduler threads (0 = CAF default).
+  size_t num_workers = 0;
+  scheduler_policy policy = scheduler_policy::stealing;
+};
+
+// Set from the command line via --caf_workers and --caf_policy and used by all
+// contexts that don't receive an explicit configuration.
+extern scheduler_config default_scheduler_config;
+
 struct caf_context {
   caf::actor_system_config cfg;
   caf::actor_system sys;
   caf_context();
+  explicit caf_context(const scheduler_config& sched);
 };
 
 using caf_context_ptr = std::unique_ptr<caf_context>;
@@ -95,4 +340,115 @@ inline auto make_caf_context() {
   return std::make_unique<caf_context>();
 }
 
-using base_fixture = benchmark::Fixture;
+inline auto make_caf_context(size_t num_workers) {
+  auto sched = default_scheduler_config;
+  sched.num_workers = num_workers;
+  return std::make_unique<caf_context>(sched);
+}
+
+inline auto make_caf_context(size_t num_workers, scheduler_policy policy) {
+  return std::make_unique<caf_context>(scheduler_config{num_workers, policy});
+}
+
+// Returns 1, 2, 4, ... up to the number of hardware threads.
+inline std::vector<int64_t> worker_count_values() {
+  auto max_workers = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<int64_t> result;
+  for (auto n = 1u; n < max_workers; n *= 2)
+    result.push_back(n);
+  result.push_back(max_workers);
+  return result;
+}
+
+// Passes 1, 2, 4, ... up to the number of hardware threads as first argument.
+inline void worker_counts(benchmark::internal::Benchmark* bench) {
+  for (auto n : worker_count_values())
+    bench->Arg(n);
+}
+
+// Like worker_counts, but passes each worker count once per scheduler policy.
+// The second argument is 0 for work stealing and 1 for work sharing.
+inline void worker_counts_and_policies(benchmark::internal::Benchmark* bench) {
+  for (int64_t policy = 0; policy < 2; ++policy)
+    for (auto n : worker_count_values())
+      bench->Args({n, policy});
+  bench->ArgNames({"workers", "sharing"});
+}
+
+// -- allocation counting ------------------------------------------------------
+
+// Set from the command line via --count_allocations.
+extern bool count_allocations;
+
+// Resets the statistics of the counting operator new/delete and starts
+// recording allocations from all threads.
+void start_allocation_counting();
+
+// Stops recording and adds allocs_per_iter, bytes_per_iter and peak_live_bytes
+// as user counters to `state`.
+void stop_allocation_counting(benchmark::State& state);
+
+// -- memory usage -------------------------------------------------------------
+
+// Returns the resident set size of this process in bytes or 0 if unavailable.
+size_t resident_memory();
+
+// -- opt-in benchmarks --------------------------------------------------------
+
+// Set from the command line via --json_large_inputs.
+extern bool json_large_inputs;
+
+// Registers the JSON benchmarks for inputs in the hundreds of MB.
+void register_large_json_benchmarks();
+
+// -- hardware performance counters --------------------------------------------
+
+// Set from the command line via --perf_counters.
+extern bool use_perf_counters;
+
+// Opens the performance counters (cycles, instructions, cache and branch
+// misses) in disabled state for the calling thread and all threads it spawns
+// afterwards. Falls back to software counters if the hardware counters are
+// unavailable. Must run before the fixture spawns any threads, e.g., the CAF
+// worker threads, to include them in the results.
+void open_perf_counters();
+
+// Resets and enables the opened performance counters.
+void start_perf_counters();
+
+// Disables the performance counters without allocating memory.
+void stop_perf_counters();
+
+// Adds the values per iteration and the IPC as user counters to `state`.
+void report_perf_counters(benchmark::State& state);
+
+// -- fixture base -------------------------------------------------------------
+
+// Base type for all fixtures. Wraps the timed part of each benchmark with the
+// allocation and performance counters if enabled.
+class base_fixture : public benchmark::Fixture {
+public:
+  using benchmark::Fixture::SetUp;
+
+  using benchmark::Fixture::TearDown;
+
+  void SetUp(benchmark::State& state) override {
+    if (use_perf_counters)
+      open_perf_counters();
+    benchmark::Fixture::SetUp(state);
+    if (count_allocations)
+      start_allocation_counting();
+    if (use_perf_counters)
+      start_perf_counters();
+  }
+
+  void TearDown(benchmark::State& state) override {
+    if (use_perf_counters)
+      stop_perf_counters();
+    if (count_allocations)
+      stop_allocation_counting(state);
+    if (use_perf_counters)
+      report_perf_counters(state);
+    benchmark::Fixture::TearDown(state);
+  }
+};
@@ -4,6 +4,10 @@
 #include "caf/message_builder.hpp"
 
 #include <cstdint>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace caf;
 
@@ -25,3 +29,151 @@ BENCHMARK_F(message_creation, message_builder)(benchmark::State& state) {
     benchmark::DoNotOptimize(msg);
   }
 }
+
+// -- messages with growing arity ----------------------------------------------
+
+namespace {
+
+template <size_t... Is>
+message make_int_message(std::index_sequence<Is...>) {
+  return make_message(static_cast<int32_t>(Is)...);
+}
+
+template <size_t N>
+void run_make_message(benchmark::State& state) {
+  for (auto _ : state) {
+    auto msg = make_int_message(std::make_index_sequence<N>{});
+    benchmark::DoNotOptimize(msg);
+  }
+}
+
+template <size_t... Ns>
+void run_make_message(benchmark::State& state, std::index_sequence<Ns...>) {
+  auto arity = static_cast<size_t>(state.range(0));
+  ((arity == Ns + 1 ? run_make_message<Ns + 1>(state) : void()), ...);
+}
+
+std::vector<int> make_int_vector(size_t n) {
+  std::vector<int> result(n);
+  std::iota(result.begin(), result.end(), 0);
+  return result;
+}
+
+} // namespace
+
+BENCHMARK_DEFINE_F(message_creation, make_message_nint)
+(benchmark::State& state) {
+  run_make_message(state, std::make_index_sequence<8>{});
+}
+
+BENCHMARK_REGISTER_F(message_creation, make_message_nint)
+  ->DenseRange(1, 8)
+  ->ArgName("arity");
+
+BENCHMARK_DEFINE_F(message_creation, message_builder_nint)
+(benchmark::State& state) {
+  auto arity = static_cast<int32_t>(state.range(0));
+  for (auto _ : state) {
+    message_builder mb;
+    for (int32_t i = 0; i < arity; ++i)
+      mb.append(i);
+    auto msg = mb.move_to_message();
+    benchmark::DoNotOptimize(msg);
+  }
+}
+
+BENCHMARK_REGISTER_F(message_creation, message_builder_nint)
+  ->DenseRange(1, 8)
+  ->ArgName("arity");
+
+// Reuses a single builder instead of creating a new one for each message.
+BENCHMARK_DEFINE_F(message_creation, message_builder_nint_reuse)
+(benchmark::State& state) {
+  auto arity = static_cast<int32_t>(state.range(0));
+  message_builder mb;
+  for (auto _ : state) {
+    mb.clear();
+    for (int32_t i = 0; i < arity; ++i)
+      mb.append(i);
+    auto msg = mb.to_message();
+    benchmark::DoNotOptimize(msg);
+  }
+}
+
+BENCHMARK_REGISTER_F(message_creation, message_builder_nint_reuse)
+  ->DenseRange(1, 8)
+  ->ArgName("arity");
+
+// -- messages with large payloads ---------------------------------------------
+
+BENCHMARK_DEFINE_F(message_creation, make_message_vector_int)
+(benchmark::State& state) {
+  auto xs = make_int_vector(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto msg = make_message(xs);
+    benchmark::DoNotOptimize(msg);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                          * static_cast<int64_t>(xs.size() * sizeof(int)));
+}
+
+BENCHMARK_REGISTER_F(message_creation, make_message_vector_int)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("n");
+
+BENCHMARK_DEFINE_F(message_creation, make_message_bar)
+(benchmark::State& state) {
+  auto len = static_cast<size_t>(state.range(0));
+  auto x = bar{foo{1, 2}, std::string(len, 'x')};
+  for (auto _ : state) {
+    auto msg = make_message(x);
+    benchmark::DoNotOptimize(msg);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                          * static_cast<int64_t>(x.b.size()));
+}
+
+BENCHMARK_REGISTER_F(message_creation, make_message_bar)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("len");
+
+// -- copy-on-write ------------------------------------------------------------
+
+// Copying a message only bumps the reference count.
+BENCHMARK_F(message_creation, copy_message)(benchmark::State& state) {
+  auto msg = make_message(int32_t{1}, int32_t{2});
+  for (auto _ : state) {
+    auto cpy = msg;
+    benchmark::DoNotOptimize(cpy);
+  }
+}
+
+// Writing to a shared message forces a deep copy of its content.
+BENCHMARK_F(message_creation, copy_and_detach_2int)(benchmark::State& state) {
+  auto msg = make_message(int32_t{1}, int32_t{2});
+  for (auto _ : state) {
+    auto cpy = msg;
+    cpy.get_mutable_as<int32_t>(0) = 42;
+    benchmark::DoNotOptimize(cpy);
+  }
+}
+
+BENCHMARK_DEFINE_F(message_creation, copy_and_detach_vector_int)
+(benchmark::State& state) {
+  auto n = static_cast<size_t>(state.range(0));
+  auto msg = make_message(make_int_vector(n));
+  for (auto _ : state) {
+    auto cpy = msg;
+    cpy.get_mutable_as<std::vector<int>>(0)[0] = 42;
+    benchmark::DoNotOptimize(cpy);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                          * static_cast<int64_t>(n * sizeof(int)));
+}
+
+BENCHMARK_REGISTER_F(message_creation, copy_and_detach_vector_int)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("n");
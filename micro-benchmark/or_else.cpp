@@ -1,5 +1,7 @@
 #include "main.hpp"
 
+#include "dispatch_handlers.hpp"
+
 #include "caf/behavior.hpp"
 #include "caf/config_value.hpp"
 #include "caf/message.hpp"
@@ -9,6 +11,8 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace caf;
 
@@ -71,7 +75,8 @@ public:
 
   void TearDown(const ::benchmark::State&) override {
     reset(native_two_ints, native_two_doubles, native_two_strings,
-          native_one_foo, native_one_bar, bhvr);
+          native_one_foo, native_one_bar, dynamic_two_ints, dynamic_two_doubles,
+          dynamic_two_strings, dynamic_one_foo, dynamic_one_bar, bhvr);
   }
 
   // -- utility for dispatching our messages -----------------------------------
@@ -100,10 +105,145 @@ BENCHMARK_F(or_else, make_message)(benchmark::State& state) {
 
 BENCHMARK_F(or_else, message_builder)(benchmark::State& state) {
   for (auto _ : state) {
-    if (!match(state, native_two_ints, 2)
-        || !match(state, native_two_doubles, 4)
-        || !match(state, native_two_strings, 6)
-        || !match(state, native_one_foo, 7) || !match(state, native_one_bar, 8))
+    if (!match(state, dynamic_two_ints, 2)
+        || !match(state, dynamic_two_doubles, 4)
+        || !match(state, dynamic_two_strings, 6)
+        || !match(state, dynamic_one_foo, 7)
+        || !match(state, dynamic_one_bar, 8))
       break;
   }
 }
+
+// -- composition cost: or_else chains vs. flat behaviors ----------------------
+
+namespace {
+
+// Creates `Depth` message handlers with `FanIn` handlers each.
+template <size_t FanIn, size_t... Js>
+std::vector<message_handler> make_links(size_t& invoked,
+                                        std::index_sequence<Js...>) {
+  return {make_dispatch_handlers<Js * FanIn>(
+    invoked, std::make_index_sequence<FanIn>{})...};
+}
+
+// Passes the chain depth as first and the fan-in per link as second argument.
+void depths_and_fan_ins(benchmark::internal::Benchmark* bench) {
+  bench->ArgsProduct({{1, 2, 4, 8, 16}, {1, 4, 16}});
+  bench->ArgNames({"depth", "fan_in"});
+}
+
+} // namespace
+
+class or_else_chain : public base_fixture {
+public:
+  size_t invoked = 0;
+
+  size_t num_handlers = 0;
+
+  // Combines all links via or_else.
+  behavior chain;
+
+  // Contains the same handlers as `chain` in a single behavior.
+  behavior flat;
+
+  // Matches the last handler, i.e., traverses the entire chain.
+  message native_last;
+
+  message dynamic_last;
+
+  void SetUp(const benchmark::State& state) override {
+    auto depth = static_cast<size_t>(state.range(0));
+    switch (state.range(1)) {
+      case 1:
+        init_fan_in<1>(depth);
+        break;
+      case 4:
+        init_fan_in<4>(depth);
+        break;
+      default:
+        init_fan_in<16>(depth);
+    }
+  }
+
+  void TearDown(const ::benchmark::State&) override {
+    reset(chain, flat, native_last, dynamic_last);
+  }
+
+  void run(benchmark::State& state, behavior& bhvr, message& msg) {
+    for (auto _ : state) {
+      invoked = 0;
+      bhvr(msg);
+      if (invoked != num_handlers) {
+        state.SkipWithError("Wrong handler called!");
+        break;
+      }
+    }
+  }
+
+private:
+  template <size_t FanIn>
+  void init_fan_in(size_t depth) {
+    switch (depth) {
+      case 1:
+        init<1, FanIn>();
+        break;
+      case 2:
+        init<2, FanIn>();
+        break;
+      case 4:
+        init<4, FanIn>();
+        break;
+      case 8:
+        init<8, FanIn>();
+        break;
+      default:
+        init<16, FanIn>();
+    }
+  }
+
+  template <size_t Depth, size_t FanIn>
+  void init() {
+    constexpr auto n = Depth * FanIn;
+    num_handlers = n;
+    auto links = make_links<FanIn>(invoked, std::make_index_sequence<Depth>{});
+    auto combined = links.front();
+    for (size_t i = 1; i < links.size(); ++i)
+      combined = combined.or_else(links[i]);
+    chain = combined;
+    flat = make_dispatch_behavior(invoked, std::make_index_sequence<n>{});
+    native_last = make_dispatch_message<n - 1>();
+    dynamic_last = make_dynamic_dispatch_message<n - 1>();
+  }
+};
+
+BENCHMARK_DEFINE_F(or_else_chain, chain_make_message)
+(benchmark::State& state) {
+  run(state, chain, native_last);
+}
+
+BENCHMARK_REGISTER_F(or_else_chain, chain_make_message)
+  ->Apply(depths_and_fan_ins);
+
+BENCHMARK_DEFINE_F(or_else_chain, chain_message_builder)
+(benchmark::State& state) {
+  run(state, chain, dynamic_last);
+}
+
+BENCHMARK_REGISTER_F(or_else_chain, chain_message_builder)
+  ->Apply(depths_and_fan_ins);
+
+BENCHMARK_DEFINE_F(or_else_chain, flat_make_message)
+(benchmark::State& state) {
+  run(state, flat, native_last);
+}
+
+BENCHMARK_REGISTER_F(or_else_chain, flat_make_message)
+  ->Apply(depths_and_fan_ins);
+
+BENCHMARK_DEFINE_F(or_else_chain, flat_message_builder)
+(benchmark::State& state) {
+  run(state, flat, dynamic_last);
+}
+
+BENCHMARK_REGISTER_F(or_else_chain, flat_message_builder)
+  ->Apply(depths_and_fan_ins);
@@ -1,5 +1,7 @@
 #include "main.hpp"
 
+#include "dispatch_handlers.hpp"
+
 #include "caf/behavior.hpp"
 #include "caf/config_value.hpp"
 #include "caf/message.hpp"
@@ -9,6 +11,7 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
 
 using namespace caf;
 
@@ -112,3 +115,99 @@ BENCHMARK_F(pattern_matching, message_builder)(benchmark::State& state) {
       break;
   }
 }
+
+// -- dispatch scaling with the number of handlers -----------------------------
+
+namespace {
+
+// Passes the number of handlers in the behavior as first argument.
+void handler_counts(benchmark::internal::Benchmark* bench) {
+  for (auto n : {1, 8, 32, 128, 256})
+    bench->Arg(n);
+  bench->ArgName("handlers");
+}
+
+} // namespace
+
+class dispatch_scaling : public base_fixture {
+public:
+  size_t num_handlers = 0;
+
+  size_t invoked = 0;
+
+  behavior bhvr;
+
+  // Matches the first handler.
+  message first_msg;
+
+  // Matches the last handler.
+  message last_msg;
+
+  // Matches no handler.
+  message no_match_msg;
+
+  void SetUp(const benchmark::State& state) override {
+    switch (state.range(0)) {
+      case 1:
+        init<1>();
+        break;
+      case 8:
+        init<8>();
+        break;
+      case 32:
+        init<32>();
+        break;
+      case 128:
+        init<128>();
+        break;
+      default:
+        init<256>();
+    }
+    no_match_msg = make_message(bar{}, bar{}, bar{}, bar{});
+  }
+
+  void TearDown(const ::benchmark::State&) override {
+    reset(bhvr, first_msg, last_msg, no_match_msg);
+  }
+
+  void run(benchmark::State& state, message& msg, size_t expected_handler_id) {
+    for (auto _ : state) {
+      invoked = 0;
+      bhvr(msg);
+      if (invoked != expected_handler_id) {
+        state.SkipWithError("Wrong handler called!");
+        break;
+      }
+    }
+  }
+
+private:
+  template <size_t N>
+  void init() {
+    num_handlers = N;
+    bhvr = make_dispatch_behavior(invoked, std::make_index_sequence<N>{});
+    first_msg = make_dispatch_message<0>();
+    last_msg = make_dispatch_message<N - 1>();
+  }
+};
+
+BENCHMARK_DEFINE_F(dispatch_scaling, first_handler)(benchmark::State& state) {
+  run(state, first_msg, 1);
+}
+
+BENCHMARK_REGISTER_F(dispatch_scaling, first_handler)
+  ->Apply(handler_counts);
+
+BENCHMARK_DEFINE_F(dispatch_scaling, last_handler)(benchmark::State& state) {
+  run(state, last_msg, num_handlers);
+}
+
+BENCHMARK_REGISTER_F(dispatch_scaling, last_handler)
+  ->Apply(handler_counts);
+
+BENCHMARK_DEFINE_F(dispatch_scaling, no_match)(benchmark::State& state) {
+  run(state, no_match_msg, 0);
+}
+
+BENCHMARK_REGISTER_F(dispatch_scaling, no_match)
+  ->Apply(handler_counts);
@@ -0,0 +1,289 @@
+#include "barrier.hpp"
+#include "latency_histogram.hpp"
+#include "main.hpp"
+
+#include "caf/detail/double_ended_queue.hpp"
+
+#if CAF_VERSION >= 10000
+#  include "caf/detail/default_mailbox.hpp"
+#  include "caf/intrusive/inbox_result.hpp"
+#  include "caf/intrusive/lifo_inbox.hpp"
+#  include "caf/mailbox_element.hpp"
+#  include "caf/message.hpp"
+#  include "caf/message_id.hpp"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+constexpr size_t items_per_producer = 10'000;
+
+int64_t now_ns() {
+  auto t = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+}
+
+// Passes the number of producer threads as first argument.
+void producer_counts(benchmark::internal::Benchmark* bench) {
+  for (auto n : {1, 2, 4, 8, 16})
+    bench->Arg(n);
+  bench->ArgName("producers");
+}
+
+// Each queue adapter below provides the same interface:
+// - push(t0) enqueues an item with the timestamp t0 (any number of threads)
+// - drain(f) blocks until at least one item is available, then calls f for the
+//   timestamp of each available item and returns the number of items (single
+//   consumer)
+
+struct item {
+  int64_t t0;
+};
+
+// Baseline: std::deque guarded by a mutex plus a condition variable.
+class mutex_deque_queue {
+public:
+  void push(int64_t t0) {
+    std::unique_lock<std::mutex> guard{mtx_};
+    items_.emplace_back(item{t0});
+    if (waiting_) {
+      waiting_ = false;
+      cv_.notify_one();
+    }
+  }
+
+  template <class F>
+  size_t drain(F f) {
+    {
+      std::unique_lock<std::mutex> guard{mtx_};
+      while (items_.empty()) {
+        waiting_ = true;
+        cv_.wait(guard);
+      }
+      buf_.swap(items_);
+    }
+    for (auto& x : buf_)
+      f(x.t0);
+    auto result = buf_.size();
+    buf_.clear();
+    return result;
+  }
+
+private:
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool waiting_ = false;
+  std::deque<item> items_;
+  std::deque<item> buf_;
+};
+
+// The double-ended queue has no blocking support, so the consumer spins.
+class deq_queue {
+public:
+  void push(int64_t t0) {
+    queue_.append(new item{t0});
+  }
+
+  template <class F>
+  size_t drain(F f) {
+    size_t result = 0;
+    for (;;) {
+      std::unique_ptr<item> ptr{queue_.take_head()};
+      if (ptr) {
+        f(ptr->t0);
+        ++result;
+      } else if (result > 0) {
+        return result;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+private:
+  detail::double_ended_queue<item> queue_;
+};
+
+#if CAF_VERSION >= 10000
+
+mailbox_element_ptr make_element(int64_t t0) {
+  return make_mailbox_element(nullptr, make_message_id(), make_message(t0));
+}
+
+int64_t timestamp(const mailbox_element& x) {
+  return x.content().get_as<int64_t>(0);
+}
+
+// Wraps a queue that supports blocking the reader (the LIFO inbox or a
+// mailbox) and wakes up the consumer the same way as blocking actors do.
+template <class Queue>
+class blocking_queue {
+public:
+  void push(int64_t t0) {
+    using intrusive::inbox_result;
+    if (queue_.push(make_element(t0)) == inbox_result::unblocked_reader) {
+      std::unique_lock<std::mutex> guard{mtx_};
+      cv_.notify_one();
+    }
+  }
+
+  template <class F>
+  size_t drain(F f) {
+    for (;;) {
+      if (auto result = queue_.pop_all(f); result > 0)
+        return result;
+      std::unique_lock<std::mutex> guard{mtx_};
+      if (queue_.impl.try_block())
+        cv_.wait(guard, [this] { return !queue_.impl.blocked(); });
+    }
+  }
+
+private:
+  Queue queue_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+};
+
+struct lifo_inbox_impl {
+  intrusive::lifo_inbox<mailbox_element> impl;
+
+  auto push(mailbox_element_ptr ptr) {
+    return impl.push_front(std::move(ptr));
+  }
+
+  // Takes all items at once (in LIFO order).
+  template <class F>
+  size_t pop_all(F& f) {
+    size_t result = 0;
+    auto ptr = impl.take_head();
+    while (ptr != nullptr) {
+      auto next = static_cast<mailbox_element*>(ptr->next);
+      f(timestamp(*ptr));
+      delete ptr;
+      ptr = next;
+      ++result;
+    }
+    return result;
+  }
+};
+
+struct mailbox_impl {
+  detail::default_mailbox impl;
+
+  auto push(mailbox_element_ptr ptr) {
+    return impl.push_back(std::move(ptr));
+  }
+
+  template <class F>
+  size_t pop_all(F& f) {
+    size_t result = 0;
+    while (auto ptr = impl.pop_front()) {
+      f(timestamp(*ptr));
+      ++result;
+    }
+    return result;
+  }
+};
+
+using lifo_inbox_queue = blocking_queue<lifo_inbox_impl>;
+
+using mailbox_queue = blocking_queue<mailbox_impl>;
+
+#endif
+
+} // namespace
+
+class queues : public base_fixture {
+public:
+  latency_histogram latencies;
+
+  void SetUp(const benchmark::State&) override {
+    latencies.reset();
+  }
+
+  // Runs one consumer (the benchmark thread) and N producers, each enqueueing
+  // items_per_producer items per iteration. Records the time from enqueueing
+  // to dequeueing each item, which includes waking up the consumer.
+  template <class Queue>
+  void run(benchmark::State& state, const std::string& name) {
+    auto num_producers = static_cast<size_t>(state.range(0));
+    auto num_items = num_producers * items_per_producer;
+    Queue queue;
+    // Note: the barrier does not allow a thread to arrive for the next phase
+    // before all threads have left the current one, hence two barriers.
+    barrier start{static_cast<ptrdiff_t>(num_producers + 1)};
+    barrier stop{static_cast<ptrdiff_t>(num_producers + 1)};
+    start.mode(default_barrier_mode);
+    stop.mode(default_barrier_mode);
+    std::atomic<bool> done{false};
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < num_producers; ++i) {
+      producers.emplace_back([&queue, &start, &stop, &done] {
+        for (;;) {
+          start.arrive_and_wait();
+          if (done)
+            return;
+          for (size_t j = 0; j < items_per_producer; ++j)
+            queue.push(now_ns());
+          stop.arrive_and_wait();
+        }
+      });
+    }
+    auto record = [this](int64_t t0) {
+      latencies.record(static_cast<uint64_t>(now_ns() - t0));
+    };
+    for (auto _ : state) {
+      start.arrive_and_wait();
+      for (size_t n = 0; n < num_items;)
+        n += queue.drain(record);
+      stop.arrive_and_wait();
+    }
+    done = true;
+    start.arrive_and_wait();
+    for (auto& producer : producers)
+      producer.join();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(num_items));
+    latencies.report(state, "queues/" + name
+                              + "/producers:" + std::to_string(num_producers));
+  }
+};
+
+BENCHMARK_DEFINE_F(queues, mutex_deque)(benchmark::State& state) {
+  run<mutex_deque_queue>(state, "mutex_deque");
+}
+
+BENCHMARK_REGISTER_F(queues, mutex_deque)->Apply(producer_counts);
+
+BENCHMARK_DEFINE_F(queues, double_ended_queue)(benchmark::State& state) {
+  run<deq_queue>(state, "double_ended_queue");
+}
+
+BENCHMARK_REGISTER_F(queues, double_ended_queue)->Apply(producer_counts);
+
+#if CAF_VERSION >= 10000
+
+BENCHMARK_DEFINE_F(queues, lifo_inbox)(benchmark::State& state) {
+  run<lifo_inbox_queue>(state, "lifo_inbox");
+}
+
+BENCHMARK_REGISTER_F(queues, lifo_inbox)->Apply(producer_counts);
+
+BENCHMARK_DEFINE_F(queues, mailbox)(benchmark::State& state) {
+  run<mailbox_queue>(state, "mailbox");
+}
+
+BENCHMARK_REGISTER_F(queues, mailbox)->Apply(producer_counts);
+
+#endif
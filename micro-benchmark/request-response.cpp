@@ -0,0 +1,284 @@
+#include "latency_histogram.hpp"
+#include "main.hpp"
+
+#include "caf/event_based_actor.hpp"
+#include "caf/exit_reason.hpp"
+#include "caf/scoped_actor.hpp"
+#include "caf/send.hpp"
+
+#if CAF_VERSION >= 1800
+#  include "caf/typed_actor.hpp"
+#  include "caf/typed_event_based_actor.hpp"
+#endif
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+// -- the responding side ------------------------------------------------------
+
+behavior pong() {
+  return {
+    [](int32_t x) { return x; },
+    [](const foo& x) { return x; },
+    [](const bar& x) { return x; },
+  };
+}
+
+#if CAF_VERSION >= 1800
+
+using pong_actor = typed_actor<result<int32_t>(int32_t), result<foo>(foo),
+                               result<bar>(bar)>;
+
+pong_actor::behavior_type typed_pong() {
+  return {
+    [](int32_t x) { return x; },
+    [](const foo& x) { return x; },
+    [](const bar& x) { return x; },
+  };
+}
+
+#endif
+
+// -- the requesting side ------------------------------------------------------
+
+// Sends one request at a time to `pong` until `remaining` drops to zero and
+// then notifies `listener`.
+template <class T, class Handle>
+struct ping_state {
+  event_based_actor* self;
+  Handle pong;
+  actor listener;
+  T value;
+  size_t remaining;
+  latency_histogram* latencies;
+
+  ping_state(event_based_actor* self, Handle pong, actor listener,
+             size_t num_round_trips, latency_histogram* latencies)
+    : self(self),
+      pong(std::move(pong)),
+      listener(std::move(listener)),
+      value(make_sample<T>()),
+      remaining(num_round_trips),
+      latencies(latencies) {
+    // nop
+  }
+};
+
+template <class T, class Handle>
+void ping_next(std::shared_ptr<ping_state<T, Handle>> st) {
+  if (st->remaining == 0) {
+    st->self->send(st->listener, true);
+    return;
+  }
+  --st->remaining;
+  auto self = st->self;
+  auto t0 = latency_histogram::clock_type::now();
+  self->request(st->pong, infinite, st->value).then([st, t0](const T&) {
+    st->latencies->record_since(t0);
+    ping_next(st);
+  });
+}
+
+template <class T, class Handle>
+void ping(event_based_actor* self, Handle pong, actor listener,
+          size_t num_round_trips, latency_histogram* latencies) {
+  using state_t = ping_state<T, Handle>;
+  ping_next(std::make_shared<state_t>(self, std::move(pong),
+                                      std::move(listener), num_round_trips,
+                                      latencies));
+}
+
+} // namespace
+
+// -- fixture ------------------------------------------------------------------
+
+class request_response : public base_fixture {
+public:
+  static constexpr size_t num_round_trips = 1'000;
+
+  caf_context_ptr context;
+
+  latency_histogram latencies;
+
+  // Spawned once per benchmark to keep spawning and termination of the pong
+  // actors out of the measurement.
+  actor pong_hdl;
+
+#if CAF_VERSION >= 1800
+  pong_actor typed_pong_hdl;
+#endif
+
+  void SetUp(const benchmark::State& state) override {
+    context = make_caf_context(static_cast<size_t>(state.range(0)));
+    latencies.reset();
+    pong_hdl = context->sys.spawn(pong);
+#if CAF_VERSION >= 1800
+    typed_pong_hdl = context->sys.spawn(typed_pong);
+#endif
+  }
+
+  void TearDown(const ::benchmark::State&) override {
+    anon_send_exit(pong_hdl, exit_reason::user_shutdown);
+    pong_hdl = actor{};
+#if CAF_VERSION >= 1800
+    anon_send_exit(typed_pong_hdl, exit_reason::user_shutdown);
+    typed_pong_hdl = pong_actor{};
+#endif
+    context.reset();
+  }
+
+  template <class T>
+  void event_based(benchmark::State& state, const char* name) {
+    run_ping<T>(state, name, pong_hdl);
+  }
+
+  template <class T>
+  void scoped(benchmark::State& state, const char* name) {
+    auto& sys = context->sys;
+    auto value = make_sample<T>();
+    scoped_actor self{sys};
+    auto failed = false;
+    for (auto _ : state) {
+      for (size_t i = 0; i < num_round_trips && !failed; ++i) {
+        auto t0 = latency_histogram::clock_type::now();
+        self->request(pong_hdl, infinite, value)
+          .receive([](const T&) {},
+                   [&state, &failed](error& err) {
+                     state.SkipWithError(to_string(err).c_str());
+                     failed = true;
+                   });
+        if (!failed)
+          latencies.record_since(t0);
+      }
+      if (failed)
+        break;
+    }
+    if (!failed)
+      report(state, name);
+  }
+
+#if CAF_VERSION >= 1800
+  template <class T>
+  void typed(benchmark::State& state, const char* name) {
+    run_ping<T>(state, name, typed_pong_hdl);
+  }
+#endif
+
+private:
+  // Spawns a ping actor per iteration and waits for its notification.
+  template <class T, class Handle>
+  void run_ping(benchmark::State& state, const char* name, Handle hdl) {
+    auto& sys = context->sys;
+    scoped_actor self{sys};
+    for (auto _ : state) {
+      sys.spawn(ping<T, Handle>, hdl, actor{self}, num_round_trips,
+                &latencies);
+      self->receive([](bool) {});
+    }
+    report(state, name);
+  }
+
+  // Reports round trips per second, the average time per round trip and the
+  // latency percentiles.
+  void report(benchmark::State& state, const char* name) {
+    using benchmark::Counter;
+    auto n = static_cast<double>(num_round_trips);
+    state.counters["round_trips"] = Counter(n,
+                                            Counter::kIsIterationInvariantRate);
+    state.counters["latency"]
+      = Counter(n, Counter::kIsIterationInvariantRate | Counter::kInvert);
+    auto full_name = "request_response/"s;
+    full_name += name;
+    full_name += "/workers:";
+    full_name += std::to_string(state.range(0));
+    latencies.report(state, full_name);
+  }
+};
+
+// -- event-based actors -------------------------------------------------------
+
+BENCHMARK_DEFINE_F(request_response, event_based_int)(benchmark::State& state) {
+  event_based<int32_t>(state, "event_based_int");
+}
+
+BENCHMARK_REGISTER_F(request_response, event_based_int)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(request_response, event_based_foo)(benchmark::State& state) {
+  event_based<foo>(state, "event_based_foo");
+}
+
+BENCHMARK_REGISTER_F(request_response, event_based_foo)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(request_response, event_based_bar)(benchmark::State& state) {
+  event_based<bar>(state, "event_based_bar");
+}
+
+BENCHMARK_REGISTER_F(request_response, event_based_bar)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+// -- scoped actor -------------------------------------------------------------
+
+BENCHMARK_DEFINE_F(request_response, scoped_int)(benchmark::State& state) {
+  scoped<int32_t>(state, "scoped_int");
+}
+
+BENCHMARK_REGISTER_F(request_response, scoped_int)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(request_response, scoped_foo)(benchmark::State& state) {
+  scoped<foo>(state, "scoped_foo");
+}
+
+BENCHMARK_REGISTER_F(request_response, scoped_foo)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(request_response, scoped_bar)(benchmark::State& state) {
+  scoped<bar>(state, "scoped_bar");
+}
+
+BENCHMARK_REGISTER_F(request_response, scoped_bar)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+// -- typed actors -------------------------------------------------------------
+
+#if CAF_VERSION >= 1800
+
+BENCHMARK_DEFINE_F(request_response, typed_int)(benchmark::State& state) {
+  typed<int32_t>(state, "typed_int");
+}
+
+BENCHMARK_REGISTER_F(request_response, typed_int)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(request_response, typed_foo)(benchmark::State& state) {
+  typed<foo>(state, "typed_foo");
+}
+
+BENCHMARK_REGISTER_F(request_response, typed_foo)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(request_response, typed_bar)(benchmark::State& state) {
+  typed<bar>(state, "typed_bar");
+}
+
+BENCHMARK_REGISTER_F(request_response, typed_bar)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+#endif
@@ -0,0 +1,162 @@
+#include "main.hpp"
+
+#include "caf/actor_cast.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/exit_reason.hpp"
+#include "caf/scoped_actor.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+// Burns some CPU cycles to simulate a unit of work.
+uint64_t busy_work(uint64_t n) {
+  uint64_t x = 0;
+  for (uint64_t i = 0; i < n; ++i) {
+    x = x * 31 + i;
+    benchmark::DoNotOptimize(x);
+  }
+  return x;
+}
+
+// -- fork-join: a root repeatedly forks tasks and waits for all results -------
+
+struct fork_join_state {
+  size_t rounds;
+  size_t pending = 0;
+};
+
+void fork_join_task(event_based_actor* self, actor parent, uint64_t task_size) {
+  self->send(parent, busy_work(task_size));
+}
+
+behavior fork_join_root(event_based_actor* self, size_t num_rounds,
+                        size_t num_tasks, uint64_t task_size) {
+  auto st = std::make_shared<fork_join_state>();
+  st->rounds = num_rounds;
+  auto fork = [self, st, num_tasks, task_size] {
+    --st->rounds;
+    st->pending = num_tasks;
+    for (size_t i = 0; i < num_tasks; ++i)
+      self->spawn(fork_join_task, actor_cast<actor>(self), task_size);
+  };
+  fork();
+  return {
+    [self, st, fork](uint64_t) {
+      if (--st->pending > 0)
+        return;
+      if (st->rounds > 0)
+        fork();
+      else
+        self->quit();
+    },
+  };
+}
+
+#if CAF_VERSION >= 1800
+
+// -- actor tree: inner nodes scatter requests and gather the results ----------
+
+struct tree_node_state {
+  size_t pending;
+  uint64_t sum = 0;
+};
+
+behavior tree_node(event_based_actor* self, size_t depth, size_t fan_out) {
+  if (depth == 0)
+    return {
+      [](uint64_t task_size) { return busy_work(task_size); },
+    };
+  std::vector<actor> children;
+  for (size_t i = 0; i < fan_out; ++i)
+    children.emplace_back(self->spawn<linked>(tree_node, depth - 1, fan_out));
+  return {
+    [self, children](uint64_t task_size) {
+      auto rp = self->make_response_promise<uint64_t>();
+      auto st = std::make_shared<tree_node_state>();
+      st->pending = children.size();
+      for (auto& child : children)
+        self->request(child, infinite, task_size)
+          .then([rp, st](uint64_t x) mutable {
+            st->sum += x;
+            if (--st->pending == 0)
+              rp.deliver(st->sum);
+          });
+      return rp;
+    },
+  };
+}
+
+#endif
+
+} // namespace
+
+class scheduler_scaling : public base_fixture {
+public:
+  caf_context_ptr context;
+
+  void SetUp(const benchmark::State& state) override {
+    auto policy = state.range(1) == 0 ? scheduler_policy::stealing
+                                      : scheduler_policy::sharing;
+    context = make_caf_context(static_cast<size_t>(state.range(0)), policy);
+  }
+
+  void TearDown(const ::benchmark::State&) override {
+    context.reset();
+  }
+};
+
+BENCHMARK_DEFINE_F(scheduler_scaling, fork_join)
+(benchmark::State& state) {
+  constexpr size_t num_rounds = 10;
+  constexpr size_t num_tasks = 64;
+  constexpr uint64_t task_size = 10'000;
+  auto& sys = context->sys;
+  for (auto _ : state) {
+    sys.spawn(fork_join_root, num_rounds, num_tasks, task_size);
+    sys.await_all_actors_done();
+  }
+  state.counters["tasks"] = benchmark::Counter(
+    num_rounds * num_tasks, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_REGISTER_F(scheduler_scaling, fork_join)
+  ->Apply(worker_counts_and_policies);
+
+#if CAF_VERSION >= 1800
+
+BENCHMARK_DEFINE_F(scheduler_scaling, actor_tree)
+(benchmark::State& state) {
+  constexpr size_t depth = 3;
+  constexpr size_t fan_out = 8;
+  constexpr uint64_t task_size = 1'000;
+  auto& sys = context->sys;
+  auto root = sys.spawn(tree_node, depth, fan_out);
+  scoped_actor self{sys};
+  auto failed = false;
+  for (auto _ : state) {
+    self->request(root, infinite, task_size)
+      .receive([](uint64_t) {},
+               [&state, &failed](error& err) {
+                 state.SkipWithError(to_string(err).c_str());
+                 failed = true;
+               });
+    if (failed)
+      break;
+  }
+  self->send_exit(root, exit_reason::user_shutdown);
+  size_t num_leaves = 1;
+  for (size_t i = 0; i < depth; ++i)
+    num_leaves *= fan_out;
+  state.counters["tasks"] = benchmark::Counter(
+    num_leaves, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_REGISTER_F(scheduler_scaling, actor_tree)
+  ->Apply(worker_counts_and_policies);
+
+#endif
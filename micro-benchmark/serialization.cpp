@@ -3,13 +3,19 @@
 #include "caf/binary_deserializer.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/message.hpp"
+#include "caf/message_builder.hpp"
 
 #if CAF_VERSION < 10000
 #include "caf/make_message.hpp"
 #endif
 
+#include <cstring>
+#include <map>
+#include <numeric>
 #include <random>
+#include <string>
 #include <tuple>
+#include <vector>
 
 #if CAF_VERSION < 1700
 using container_type = std::vector<char>;
@@ -31,6 +37,50 @@ void apply(Inspector& inspector, T& x) {
 
 using namespace caf;
 
+namespace {
+
+// -- payloads with configurable size ------------------------------------------
+
+std::vector<int> make_int_vector(size_t n) {
+  std::vector<int> result(n);
+  std::iota(result.begin(), result.end(), 0);
+  return result;
+}
+
+std::string make_string(size_t n) {
+  std::string result(n, ' ');
+  for (size_t i = 0; i < n; ++i)
+    result[i] = static_cast<char>('a' + i % 26);
+  return result;
+}
+
+std::map<std::string, int32_t> make_string_map(size_t n) {
+  std::map<std::string, int32_t> result;
+  for (size_t i = 0; i < n; ++i)
+    result.emplace("key-" + std::to_string(i), static_cast<int32_t>(i));
+  return result;
+}
+
+std::vector<bar> make_bar_vector(size_t n) {
+  std::vector<bar> result;
+  result.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    auto x = static_cast<int32_t>(i);
+    result.emplace_back(bar{foo{x, x + 1}, "bar-" + std::to_string(i)});
+  }
+  return result;
+}
+
+// Creates a message with `n` integer elements.
+message make_int_message(size_t n) {
+  message_builder mb;
+  for (size_t i = 0; i < n; ++i)
+    mb.append(static_cast<int32_t>(i));
+  return mb.to_message();
+}
+
+} // namespace
+
 class serialization : public base_fixture {
 public:
   caf_context_ptr context;
@@ -89,6 +139,34 @@ public:
     context.reset();
   }
 
+  // -- utility for benchmarks with configurable payload size ------------------
+
+  template <class T>
+  void run_save(benchmark::State& state, T& x) {
+    for (auto _ : state) {
+      buf.clear();
+      binary_serializer sink{context->sys, buf};
+      apply(sink, x);
+      benchmark::DoNotOptimize(buf);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(buf.size()));
+  }
+
+  template <class T>
+  void run_load(benchmark::State& state, T x) {
+    container_type bytes;
+    store(std::move(x), bytes);
+    for (auto _ : state) {
+      T result;
+      binary_deserializer source{context->sys, bytes};
+      apply(source, result);
+      benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(bytes.size()));
+  }
+
 private:
   template <class T>
   void store(T x, container_type& storage) {
@@ -186,3 +264,152 @@ BENCHMARK_F(serialization, load_msg_2int_binary)(benchmark::State& state) {
     benchmark::DoNotOptimize(result);
   }
 }
+
+// -- benchmarks with configurable payload size --------------------------------
+
+BENCHMARK_DEFINE_F(serialization, save_vector_int_binary)
+(benchmark::State& state) {
+  auto x = make_int_vector(static_cast<size_t>(state.range(0)));
+  run_save(state, x);
+}
+
+BENCHMARK_REGISTER_F(serialization, save_vector_int_binary)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("n");
+
+BENCHMARK_DEFINE_F(serialization, load_vector_int_binary)
+(benchmark::State& state) {
+  run_load(state, make_int_vector(static_cast<size_t>(state.range(0))));
+}
+
+BENCHMARK_REGISTER_F(serialization, load_vector_int_binary)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("n");
+
+BENCHMARK_DEFINE_F(serialization, save_string_binary)
+(benchmark::State& state) {
+  auto x = make_string(static_cast<size_t>(state.range(0)));
+  run_save(state, x);
+}
+
+BENCHMARK_REGISTER_F(serialization, save_string_binary)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("n");
+
+BENCHMARK_DEFINE_F(serialization, load_string_binary)
+(benchmark::State& state) {
+  run_load(state, make_string(static_cast<size_t>(state.range(0))));
+}
+
+BENCHMARK_REGISTER_F(serialization, load_string_binary)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("n");
+
+BENCHMARK_DEFINE_F(serialization, save_string_map_binary)
+(benchmark::State& state) {
+  auto x = make_string_map(static_cast<size_t>(state.range(0)));
+  run_save(state, x);
+}
+
+BENCHMARK_REGISTER_F(serialization, save_string_map_binary)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("n");
+
+BENCHMARK_DEFINE_F(serialization, load_string_map_binary)
+(benchmark::State& state) {
+  run_load(state, make_string_map(static_cast<size_t>(state.range(0))));
+}
+
+BENCHMARK_REGISTER_F(serialization, load_string_map_binary)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("n");
+
+BENCHMARK_DEFINE_F(serialization, save_vector_bar_binary)
+(benchmark::State& state) {
+  auto x = make_bar_vector(static_cast<size_t>(state.range(0)));
+  run_save(state, x);
+}
+
+BENCHMARK_REGISTER_F(serialization, save_vector_bar_binary)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("n");
+
+BENCHMARK_DEFINE_F(serialization, load_vector_bar_binary)
+(benchmark::State& state) {
+  run_load(state, make_bar_vector(static_cast<size_t>(state.range(0))));
+}
+
+BENCHMARK_REGISTER_F(serialization, load_vector_bar_binary)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("n");
+
+// Note: messages store meta data per element, so we stop at 10k elements.
+
+BENCHMARK_DEFINE_F(serialization, save_msg_nint_binary)
+(benchmark::State& state) {
+  auto x = make_int_message(static_cast<size_t>(state.range(0)));
+  run_save(state, x);
+}
+
+BENCHMARK_REGISTER_F(serialization, save_msg_nint_binary)
+  ->RangeMultiplier(10)
+  ->Range(10, 10'000)
+  ->ArgName("n");
+
+BENCHMARK_DEFINE_F(serialization, load_msg_nint_binary)
+(benchmark::State& state) {
+  run_load(state, make_int_message(static_cast<size_t>(state.range(0))));
+}
+
+BENCHMARK_REGISTER_F(serialization, load_msg_nint_binary)
+  ->RangeMultiplier(10)
+  ->Range(10, 10'000)
+  ->ArgName("n");
+
+// -- memcpy baselines for trivially copyable payloads -------------------------
+
+BENCHMARK_DEFINE_F(serialization, save_vector_int_memcpy)
+(benchmark::State& state) {
+  auto x = make_int_vector(static_cast<size_t>(state.range(0)));
+  auto num_bytes = x.size() * sizeof(int);
+  for (auto _ : state) {
+    buf.resize(num_bytes);
+    memcpy(buf.data(), x.data(), num_bytes);
+    benchmark::DoNotOptimize(buf);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                          * static_cast<int64_t>(num_bytes));
+}
+
+BENCHMARK_REGISTER_F(serialization, save_vector_int_memcpy)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("n");
+
+BENCHMARK_DEFINE_F(serialization, load_vector_int_memcpy)
+(benchmark::State& state) {
+  auto n = static_cast<size_t>(state.range(0));
+  auto num_bytes = n * sizeof(int);
+  container_type bytes(num_bytes);
+  // Allocate once to keep value-initialization out of the measurement.
+  std::vector<int> result(n);
+  for (auto _ : state) {
+    memcpy(result.data(), bytes.data(), num_bytes);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                          * static_cast<int64_t>(num_bytes));
+}
+
+BENCHMARK_REGISTER_F(serialization, load_vector_int_memcpy)
+  ->RangeMultiplier(10)
+  ->Range(10, 1'000'000)
+  ->ArgName("n");
@@ -1,6 +1,9 @@
 #include "barrier.hpp"
+#include "latency_histogram.hpp"
 #include "main.hpp"
 
+#include "caf/behavior.hpp"
+#include "caf/binary_deserializer.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/byte_buffer.hpp"
 #include "caf/event_based_actor.hpp"
@@ -18,6 +21,8 @@
 
 #include <cstdint>
 #include <numeric>
+#include <string>
+#include <utility>
 #include <vector>
 
 #ifdef CAF_POSIX
@@ -44,6 +49,9 @@ public:
 
   void SetUp(const benchmark::State&) override {
     fin = false;
+    latencies.reset();
+    start.mode(default_barrier_mode);
+    stop.mode(default_barrier_mode);
     std::tie(ping_sock, pong_sock) = *net::make_stream_socket_pair();
     // Note: for the length-prefix framing, we need a 32-bit size header.
     {
@@ -88,6 +96,17 @@ public:
     };
   }
 
+  // Runs one ping-pong round per iteration and records its latency.
+  void run(benchmark::State& state, const char* name) {
+    for (auto _ : state) {
+      auto t0 = latency_histogram::clock_type::now();
+      start.arrive_and_wait();
+      stop.arrive_and_wait();
+      latencies.record_since(t0);
+    }
+    latencies.report(state, name);
+  }
+
   net::stream_socket ping_sock;
   net::stream_socket pong_sock;
   byte_buffer ping_out;
@@ -100,10 +119,34 @@ public:
   barrier stop;
   std::thread sender;
   std::thread receiver;
+  latency_histogram latencies;
 };
 
 } // namespace
 
+// -- baseline: synchronization overhead without any I/O -----------------------
+
+namespace {
+
+// Runs the same three-thread barrier protocol as the ping_pong benchmarks, but
+// with no-op workers. Subtracting this from the ping_pong numbers leaves the
+// cost of the actual socket I/O.
+class socket_communication_barrier : public socket_fixture {
+public:
+  void SetUp(const benchmark::State& state) override {
+    socket_fixture::SetUp(state);
+    sender = std::thread{loop([] {})};
+    receiver = std::thread{loop([] {})};
+  }
+};
+
+} // namespace
+
+BENCHMARK_F(socket_communication_barrier, barrier_only)
+(benchmark::State& state) {
+  run(state, "socket_communication_barrier/barrier_only");
+}
+
 // -- baseline: direct access to the POSIX socket API --------------------------
 
 #ifdef CAF_POSIX
@@ -140,10 +183,7 @@ public:
 } // namespace
 
 BENCHMARK_F(socket_communication_posix, ping_pong)(benchmark::State& state) {
-  for (auto _ : state) {
-    start.arrive_and_wait();
-    stop.arrive_and_wait();
-  }
+  run(state, "socket_communication_posix/ping_pong");
 }
 
 #endif // CAF_POSIX
@@ -174,10 +214,7 @@ public:
 } // namespace
 
 BENCHMARK_F(socket_communication_raw, ping_pong)(benchmark::State& state) {
-  for (auto _ : state) {
-    start.arrive_and_wait();
-    stop.arrive_and_wait();
-  }
+  run(state, "socket_communication_raw/ping_pong");
 }
 
 // -- reading via octet_stream::transport --------------------------------------
@@ -289,20 +326,20 @@ public:
 } // namespace
 
 BENCHMARK_F(socket_communication_stream_transport, ping_pong)(benchmark::State& state) {
-  for (auto _ : state) {
-    start.arrive_and_wait();
-    stop.arrive_and_wait();
-  }
+  run(state, "socket_communication_stream_transport/ping_pong");
 }
 
 // -- reading via length_prefix_framing (lpf) ----------------------------------
 
 namespace {
 
-class pong_msg_application : public net::lp::upper_layer {
+// Implements the read/write cycle of the lpf benchmarks. For each incoming
+// message, calls `reply(msg, buf)` to fill the response into `buf`.
+template <class Reply>
+class reply_msg_application : public net::lp::upper_layer {
 public:
-  pong_msg_application(byte_buffer* in, byte_buffer* out)
-    : state_(app_state::done), in_(in), out_(out) {
+  explicit reply_msg_application(Reply reply)
+    : state_(app_state::done), reply_(std::move(reply)) {
     // nop
   }
 
@@ -324,18 +361,10 @@ public:
   }
 
   ptrdiff_t consume(byte_span msg) override {
-    if (msg.size() != in_->size() - sizeof(uint32_t)) {
-      std::string msg = "unexpected data: expected ";
-      msg += std::to_string(in_->size() - sizeof(uint32_t));
-      msg += " bytes, got ";
-      msg += std::to_string(msg.size());
-      CAF_CRITICAL(msg.c_str());
-    }
     if (state_ != app_state::reading)
       CAF_CRITICAL("consume called but app is not reading!");
     down_->begin_message();
-    auto& buf = down_->message_buffer();
-    buf.insert(buf.end(), out_->begin() + sizeof(uint32_t), out_->end());
+    reply_(msg, down_->message_buffer());
     if (!down_->end_message())
       CAF_CRITICAL("end_message failed");
     state_ = app_state::writing;
@@ -357,10 +386,34 @@ public:
 private:
   net::lp::lower_layer* down_ = nullptr;
   app_state state_;
+  Reply reply_;
+};
+
+// Checks the size of each message and responds with a pre-serialized payload.
+class pong_reply {
+public:
+  pong_reply(byte_buffer* in, byte_buffer* out) : in_(in), out_(out) {
+    // nop
+  }
+
+  void operator()(byte_span msg, byte_buffer& buf) {
+    if (msg.size() != in_->size() - sizeof(uint32_t)) {
+      std::string what = "unexpected data: expected ";
+      what += std::to_string(in_->size() - sizeof(uint32_t));
+      what += " bytes, got ";
+      what += std::to_string(msg.size());
+      CAF_CRITICAL(what.c_str());
+    }
+    buf.insert(buf.end(), out_->begin() + sizeof(uint32_t), out_->end());
+  }
+
+private:
   byte_buffer* in_;
   byte_buffer* out_;
 };
 
+using pong_msg_application = reply_msg_application<pong_reply>;
+
 class socket_communication_lpf : public socket_fixture {
 public:
   void SetUp(const benchmark::State& state) override {
@@ -380,7 +433,7 @@ public:
       mpx->apply_updates();
       if (auto err = mpx->init())
         CAF_CRITICAL("mpx->init failed");
-      auto app = std::make_unique<app_t>(&pong_in, &pong_out);
+      auto app = std::make_unique<app_t>(pong_reply{&pong_in, &pong_out});
       auto app_ptr = app.get();
       auto framing = net::lp::framing::make(std::move(app));
       auto transport = net::octet_stream::transport::make(pong_sock,
@@ -406,8 +459,180 @@ public:
 } // namespace
 
 BENCHMARK_F(socket_communication_lpf, ping_pong)(benchmark::State& state) {
-  for (auto _ : state) {
-    start.arrive_and_wait();
-    stop.arrive_and_wait();
+  run(state, "socket_communication_lpf/ping_pong");
+}
+
+// -- end-to-end: serialization, lpf and dispatching of actor messages ---------
+
+namespace {
+
+// Number of integers in the std::vector<int> payload.
+constexpr size_t vector_payload_size = 1'000;
+
+message make_payload(int64_t type) {
+  switch (type) {
+    case 0:
+      return make_message(make_sample<foo>());
+    case 1:
+      return make_message(make_sample<bar>());
+    default: {
+      std::vector<int> xs(vector_payload_size);
+      std::iota(xs.begin(), xs.end(), 0);
+      return make_message(std::move(xs));
+    }
+  }
+}
+
+// Serializes `msg` into `buf`, prefixed by its size as 32-bit header.
+void serialize_frame(byte_buffer& buf, const message& msg) {
+  buf.clear();
+  caf::binary_serializer sink{nullptr, buf};
+  sink.skip(sizeof(uint32_t));
+  APPLY_OR_DIE(sink, msg);
+  sink.seek(0);
+  APPLY_OR_DIE(sink, static_cast<uint32_t>(buf.size() - sizeof(uint32_t)));
+}
+
+message deserialize_message(const_byte_span bytes) {
+  message result;
+  caf::binary_deserializer source{nullptr, bytes};
+  APPLY_OR_DIE(source, result);
+  return result;
+}
+
+void write_all(net::stream_socket fd, const_byte_span buf) {
+  while (!buf.empty()) {
+    auto n = net::write(fd, buf);
+    if (n <= 0)
+      CAF_CRITICAL("failed to write buffer");
+    buf = buf.subspan(static_cast<size_t>(n));
+  }
+}
+
+void read_all(net::stream_socket fd, byte_span buf) {
+  while (!buf.empty()) {
+    auto n = net::read(fd, buf);
+    if (n <= 0)
+      CAF_CRITICAL("failed to read buffer");
+    buf = buf.subspan(static_cast<size_t>(n));
   }
 }
+
+// Responds to each message with a copy of its content.
+behavior echo_behavior() {
+  return {
+    [](foo& x) { return std::move(x); },
+    [](bar& x) { return std::move(x); },
+    [](std::vector<int>& xs) { return std::move(xs); },
+  };
+}
+
+// Accepts the echoed messages on the sender side.
+behavior accept_behavior() {
+  return {
+    [](const foo&) {},
+    [](const bar&) {},
+    [](const std::vector<int>&) {},
+  };
+}
+
+// Deserializes each frame to a message, dispatches it to the echo behavior and
+// serializes the result as response.
+class echo_reply {
+public:
+  echo_reply() : bhvr_(echo_behavior()) {
+    // nop
+  }
+
+  void operator()(byte_span frame, byte_buffer& buf) {
+    auto msg = deserialize_message(frame);
+    auto res = bhvr_(msg);
+    if (!res)
+      CAF_CRITICAL("echo behavior failed to handle the message");
+    caf::binary_serializer sink{nullptr, buf};
+    APPLY_OR_DIE(sink, *res);
+  }
+
+private:
+  behavior bhvr_;
+};
+
+using echo_msg_application = reply_msg_application<echo_reply>;
+
+// Sends actor messages through the full pipeline on both sides. The first
+// argument selects the payload: 0 = foo, 1 = bar, 2 = std::vector<int>.
+class socket_communication_lpf_message : public socket_fixture {
+public:
+  void SetUp(const benchmark::State& state) override {
+    socket_fixture::SetUp(state);
+    payload = make_payload(state.range(0));
+    serialize_frame(ping_out, payload);
+    if (auto err = net::nonblocking(pong_sock, true))
+      CAF_CRITICAL("nonblocking(pong_sock) failed");
+    accept = accept_behavior();
+    sender = std::thread{loop([this] {
+      serialize_frame(ping_out, payload);
+      write_all(ping_sock, ping_out);
+      ping_in.resize(sizeof(uint32_t));
+      read_all(ping_sock, ping_in);
+      uint32_t len = 0;
+      {
+        caf::binary_deserializer source{nullptr, ping_in};
+        APPLY_OR_DIE(source, len);
+      }
+      ping_in.resize(len);
+      read_all(ping_sock, ping_in);
+      auto msg = deserialize_message(ping_in);
+      if (!accept(msg))
+        CAF_CRITICAL("unexpected response");
+    })};
+    receiver = std::thread{[this] {
+      using app_t = echo_msg_application;
+      auto mpx = net::multiplexer::make(nullptr);
+      mpx->set_thread_id();
+      mpx->apply_updates();
+      if (auto err = mpx->init())
+        CAF_CRITICAL("mpx->init failed");
+      auto app = std::make_unique<app_t>(echo_reply{});
+      auto app_ptr = app.get();
+      auto framing = net::lp::framing::make(std::move(app));
+      auto transport = net::octet_stream::transport::make(pong_sock,
+                                                          std::move(framing));
+      auto mgr = net::socket_manager::make(mpx.get(), std::move(transport));
+      if (auto err = mgr->start()) {
+        auto what = "mgr->init failed: "s;
+        what += to_string(err);
+        CAF_CRITICAL(what.c_str());
+      }
+      mpx->apply_updates();
+      auto f = loop([this, app_ptr, &mpx] {
+        app_ptr->state(app_state::reading);
+        while (app_ptr->state() != app_state::done) {
+          mpx->poll_once(true);
+        }
+      });
+      f();
+    }};
+  }
+
+  message payload;
+  behavior accept;
+};
+
+} // namespace
+
+BENCHMARK_DEFINE_F(socket_communication_lpf_message, ping_pong)
+(benchmark::State& state) {
+  using benchmark::Counter;
+  auto name = "socket_communication_lpf_message/ping_pong/type:"s;
+  name += std::to_string(state.range(0));
+  run(state, name.c_str());
+  // Each round trip carries one message in each direction.
+  state.counters["messages"] = Counter(2, Counter::kIsIterationInvariantRate);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                          * static_cast<int64_t>(2 * ping_out.size()));
+}
+
+BENCHMARK_REGISTER_F(socket_communication_lpf_message, ping_pong)
+  ->DenseRange(0, 2)
+  ->ArgName("type");
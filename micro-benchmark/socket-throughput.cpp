@@ -0,0 +1,645 @@
+#include "main.hpp"
+
+#include "caf/binary_serializer.hpp"
+#include "caf/byte_buffer.hpp"
+#include "caf/byte_span.hpp"
+#include "caf/net/lp/framing.hpp"
+#include "caf/net/lp/lower_layer.hpp"
+#include "caf/net/lp/upper_layer.hpp"
+#include "caf/net/multiplexer.hpp"
+#include "caf/net/octet_stream/lower_layer.hpp"
+#include "caf/net/octet_stream/transport.hpp"
+#include "caf/net/octet_stream/upper_layer.hpp"
+#include "caf/net/receive_policy.hpp"
+#include "caf/net/socket.hpp"
+#include "caf/net/socket_manager.hpp"
+#include "caf/net/stream_socket.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#ifdef CAF_POSIX
+#  include <sys/socket.h>
+#  include <sys/types.h>
+#  include <sys/uio.h>
+#endif
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+// -- utility for writing and reading entire buffers ---------------------------
+
+bool write_all(net::stream_socket fd, const_byte_span buf) {
+  while (!buf.empty()) {
+    auto n = net::write(fd, buf);
+    if (n <= 0)
+      return false;
+    buf = buf.subspan(static_cast<size_t>(n));
+  }
+  return true;
+}
+
+bool read_all(net::stream_socket fd, byte_span buf) {
+  while (!buf.empty()) {
+    auto n = net::read(fd, buf);
+    if (n <= 0)
+      return false;
+    buf = buf.subspan(static_cast<size_t>(n));
+  }
+  return true;
+}
+
+// -- fixture base -------------------------------------------------------------
+
+// The benchmark thread keeps the pipe full by writing `depth` messages of
+// `msg_size` bytes back-to-back and then waits for a single acknowledgement
+// from the receiver thread before writing the next batch. The first argument
+// sets the message size and the second argument sets the pipelining depth.
+class throughput_fixture : public base_fixture {
+public:
+  void SetUp(const benchmark::State& state) override {
+    msg_size = static_cast<size_t>(state.range(0));
+    depth = static_cast<size_t>(state.range(1));
+    std::tie(snd_sock, rcv_sock) = *net::make_stream_socket_pair();
+    out.assign(msg_size, std::byte{0x2A});
+    ack.resize(1);
+  }
+
+  void TearDown(const benchmark::State&) override {
+    // Closing our end causes the receiver to stop.
+    close(snd_sock);
+    receiver.join();
+    if (!rcv_sock_owned_by_mpx)
+      close(rcv_sock);
+  }
+
+  template <class Write, class Read>
+  void run(benchmark::State& state, Write write_fn, Read read_fn) {
+    for (auto _ : state) {
+      for (size_t i = 0; i < depth; ++i)
+        if (!write_fn(snd_sock, out))
+          CAF_CRITICAL("failed to write message");
+      if (!read_fn(snd_sock, ack))
+        CAF_CRITICAL("failed to read acknowledgement");
+    }
+    auto num_messages = static_cast<int64_t>(state.iterations() * depth);
+    state.SetItemsProcessed(num_messages);
+    state.SetBytesProcessed(num_messages * static_cast<int64_t>(msg_size));
+  }
+
+  void run(benchmark::State& state) {
+    run(state, write_all, read_all);
+  }
+
+  // Prepends a 32-bit size header to the outgoing message.
+  void add_length_prefix() {
+    byte_buffer buf;
+    caf::binary_serializer sink{nullptr, buf};
+    APPLY_OR_DIE(sink, static_cast<uint32_t>(msg_size));
+    buf.insert(buf.end(), out.begin(), out.end());
+    out.swap(buf);
+  }
+
+  size_t msg_size = 0;
+  size_t depth = 0;
+  net::stream_socket snd_sock;
+  net::stream_socket rcv_sock;
+  bool rcv_sock_owned_by_mpx = false;
+  byte_buffer out;
+  byte_buffer ack;
+  std::thread receiver;
+};
+
+// Sweeps message sizes from 64 B to 1 MiB and pipelining depths from 1 to 64.
+void throughput_args(benchmark::internal::Benchmark* bench) {
+  bench->ArgsProduct({{64, 1024, 16 * 1024, 64 * 1024, 1024 * 1024},
+                      {1, 8, 64}});
+  bench->ArgNames({"size", "depth"});
+}
+
+// Runs a multiplexer in the receiver thread until the application reports that
+// the sender has closed the connection.
+template <class App, class MakeTransport>
+void run_mpx(std::unique_ptr<App> app, MakeTransport make_transport) {
+  auto app_ptr = app.get();
+  auto mpx = net::multiplexer::make(nullptr);
+  mpx->set_thread_id();
+  mpx->apply_updates();
+  if (auto err = mpx->init())
+    CAF_CRITICAL("mpx->init failed");
+  auto mgr = net::socket_manager::make(mpx.get(),
+                                       make_transport(std::move(app)));
+  if (auto err = mgr->start()) {
+    auto what = "mgr->start failed: "s;
+    what += to_string(err);
+    CAF_CRITICAL(what.c_str());
+  }
+  mpx->apply_updates();
+  while (!app_ptr->done())
+    mpx->poll_once(true);
+}
+
+} // namespace
+
+// -- baseline: direct access to the POSIX socket API --------------------------
+
+#ifdef CAF_POSIX
+
+namespace {
+
+bool posix_write_all(net::stream_socket fd, const_byte_span buf) {
+  while (!buf.empty()) {
+    auto n = ::send(fd.id, buf.data(), buf.size(), 0);
+    if (n <= 0)
+      return false;
+    buf = buf.subspan(static_cast<size_t>(n));
+  }
+  return true;
+}
+
+bool posix_read_all(net::stream_socket fd, byte_span buf) {
+  while (!buf.empty()) {
+    auto n = ::recv(fd.id, buf.data(), buf.size(), 0);
+    if (n <= 0)
+      return false;
+    buf = buf.subspan(static_cast<size_t>(n));
+  }
+  return true;
+}
+
+class socket_throughput_posix : public throughput_fixture {
+public:
+  void SetUp(const benchmark::State& state) override {
+    throughput_fixture::SetUp(state);
+    receiver = std::thread{[this] {
+      byte_buffer in;
+      in.resize(msg_size);
+      for (;;) {
+        for (size_t i = 0; i < depth; ++i)
+          if (!posix_read_all(rcv_sock, in))
+            return;
+        if (!posix_write_all(rcv_sock, ack))
+          return;
+      }
+    }};
+  }
+};
+
+} // namespace
+
+BENCHMARK_DEFINE_F(socket_throughput_posix, stream)(benchmark::State& state) {
+  run(state, posix_write_all, posix_read_all);
+}
+
+BENCHMARK_REGISTER_F(socket_throughput_posix, stream)->Apply(throughput_args);
+
+#endif // CAF_POSIX
+
+// -- raw read and write on sockets using the CAF API --------------------------
+
+namespace {
+
+class socket_throughput_raw : public throughput_fixture {
+public:
+  void SetUp(const benchmark::State& state) override {
+    throughput_fixture::SetUp(state);
+    receiver = std::thread{[this] {
+      byte_buffer in;
+      in.resize(msg_size);
+      for (;;) {
+        for (size_t i = 0; i < depth; ++i)
+          if (!read_all(rcv_sock, in))
+            return;
+        if (!write_all(rcv_sock, ack))
+          return;
+      }
+    }};
+  }
+};
+
+} // namespace
+
+BENCHMARK_DEFINE_F(socket_throughput_raw, stream)(benchmark::State& state) {
+  run(state);
+}
+
+BENCHMARK_REGISTER_F(socket_throughput_raw, stream)->Apply(throughput_args);
+
+// -- reading via octet_stream::transport --------------------------------------
+
+namespace {
+
+// Consumes fixed-size messages and sends one byte after every `depth` messages.
+class sink_stream_application : public net::octet_stream::upper_layer {
+public:
+  sink_stream_application(size_t msg_size, size_t depth)
+    : msg_size_(msg_size), depth_(depth) {
+    // nop
+  }
+
+  void prepare_send() override {
+    // nop
+  }
+
+  bool done_sending() override {
+    return true;
+  }
+
+  void abort(const error&) override {
+    done_ = true;
+  }
+
+  error start(net::octet_stream::lower_layer* down) override {
+    down->configure_read(net::receive_policy::exactly(msg_size_));
+    down_ = down;
+    return none;
+  }
+
+  ptrdiff_t consume(byte_span data, byte_span) override {
+    if (++received_ == depth_) {
+      received_ = 0;
+      down_->begin_output();
+      down_->output_buffer().push_back(std::byte{1});
+      down_->end_output();
+    }
+    return static_cast<ptrdiff_t>(data.size());
+  }
+
+  bool done() const noexcept {
+    return done_;
+  }
+
+private:
+  net::octet_stream::lower_layer* down_ = nullptr;
+  size_t msg_size_;
+  size_t depth_;
+  size_t received_ = 0;
+  bool done_ = false;
+};
+
+class socket_throughput_stream_transport : public throughput_fixture {
+public:
+  void SetUp(const benchmark::State& state) override {
+    throughput_fixture::SetUp(state);
+    if (auto err = net::nonblocking(rcv_sock, true))
+      CAF_CRITICAL("nonblocking(rcv_sock) failed");
+    rcv_sock_owned_by_mpx = true;
+    receiver = std::thread{[this] {
+      using app_t = sink_stream_application;
+      run_mpx(std::make_unique<app_t>(msg_size, depth), [this](auto app) {
+        return net::octet_stream::transport::make(rcv_sock, std::move(app));
+      });
+    }};
+  }
+};
+
+} // namespace
+
+BENCHMARK_DEFINE_F(socket_throughput_stream_transport, stream)
+(benchmark::State& state) {
+  run(state);
+}
+
+BENCHMARK_REGISTER_F(socket_throughput_stream_transport, stream)
+  ->Apply(throughput_args);
+
+// -- reading via length_prefix_framing (lpf) ----------------------------------
+
+namespace {
+
+// Consumes messages and sends a one-byte message after every `depth` messages.
+class sink_msg_application : public net::lp::upper_layer {
+public:
+  explicit sink_msg_application(size_t depth) : depth_(depth) {
+    // nop
+  }
+
+  void prepare_send() override {
+    // nop
+  }
+
+  bool done_sending() override {
+    return true;
+  }
+
+  error start(net::lp::lower_layer* down) override {
+    down->request_messages();
+    down_ = down;
+    return none;
+  }
+
+  ptrdiff_t consume(byte_span msg) override {
+    if (++received_ == depth_) {
+      received_ = 0;
+      down_->begin_message();
+      down_->message_buffer().push_back(std::byte{1});
+      if (!down_->end_message())
+        CAF_CRITICAL("end_message failed");
+    }
+    return static_cast<ptrdiff_t>(msg.size());
+  }
+
+  void abort(const error&) override {
+    done_ = true;
+  }
+
+  bool done() const noexcept {
+    return done_;
+  }
+
+private:
+  net::lp::lower_layer* down_ = nullptr;
+  size_t depth_;
+  size_t received_ = 0;
+  bool done_ = false;
+};
+
+class socket_throughput_lpf : public throughput_fixture {
+public:
+  void SetUp(const benchmark::State& state) override {
+    throughput_fixture::SetUp(state);
+    add_length_prefix();
+    // The acknowledgement is a framed message with one byte of payload.
+    ack.resize(sizeof(uint32_t) + 1);
+    if (auto err = net::nonblocking(rcv_sock, true))
+      CAF_CRITICAL("nonblocking(rcv_sock) failed");
+    rcv_sock_owned_by_mpx = true;
+    receiver = std::thread{[this] {
+      using app_t = sink_msg_application;
+      run_mpx(std::make_unique<app_t>(depth), [this](auto app) {
+        auto framing = net::lp::framing::make(std::move(app));
+        return net::octet_stream::transport::make(rcv_sock,
+                                                  std::move(framing));
+      });
+    }};
+  }
+};
+
+} // namespace
+
+BENCHMARK_DEFINE_F(socket_throughput_lpf, stream)(benchmark::State& state) {
+  run(state);
+}
+
+BENCHMARK_REGISTER_F(socket_throughput_lpf, stream)->Apply(throughput_args);
+
+// -- batched writes of many small length-prefixed frames ----------------------
+
+namespace {
+
+// Sweeps small frame sizes and the number of frames per batch.
+void batching_args(benchmark::internal::Benchmark* bench) {
+  bench->ArgsProduct({{16, 64, 256, 1024}, {16, 64, 256}});
+  bench->ArgNames({"size", "depth"});
+}
+
+// Writes `depth` length-prefixed frames per iteration. The receiver reads each
+// batch as a whole and then answers with a framed one-byte acknowledgement.
+class batching_fixture : public throughput_fixture {
+public:
+  void SetUp(const benchmark::State& state) override {
+    throughput_fixture::SetUp(state);
+    add_length_prefix();
+    ack.resize(sizeof(uint32_t) + 1);
+    byte_buffer framed_ack;
+    caf::binary_serializer sink{nullptr, framed_ack};
+    APPLY_OR_DIE(sink, uint32_t{1});
+    framed_ack.push_back(std::byte{1});
+    auto batch_size = depth * out.size();
+    receiver = std::thread{[this, batch_size, framed_ack] {
+      byte_buffer in;
+      in.resize(batch_size);
+      for (;;) {
+        if (!read_all(rcv_sock, in))
+          return;
+        if (!write_all(rcv_sock, framed_ack))
+          return;
+      }
+    }};
+  }
+};
+
+} // namespace
+
+#ifdef CAF_POSIX
+
+namespace {
+
+#  ifdef IOV_MAX
+constexpr size_t max_iov = IOV_MAX;
+#  else
+constexpr size_t max_iov = 1024;
+#  endif
+
+// Writes all buffers with as few sendmsg calls as possible. Modifies `iov` to
+// keep track of partial writes.
+bool posix_sendmsg_all(net::stream_socket fd, iovec* iov, size_t count) {
+  while (count > 0) {
+    msghdr hdr{};
+    hdr.msg_iov = iov;
+    hdr.msg_iovlen = std::min(count, max_iov);
+    auto n = ::sendmsg(fd.id, &hdr, 0);
+    if (n <= 0)
+      return false;
+    auto written = static_cast<size_t>(n);
+    while (count > 0 && written >= iov->iov_len) {
+      written -= iov->iov_len;
+      ++iov;
+      --count;
+    }
+    if (written > 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+      iov->iov_len -= written;
+    }
+  }
+  return true;
+}
+
+class socket_batching_posix : public batching_fixture {
+public:
+  void SetUp(const benchmark::State& state) override {
+    batching_fixture::SetUp(state);
+    // Scatter/gather I/O with separate buffers for header and payload.
+    iov.clear();
+    for (size_t i = 0; i < depth; ++i) {
+      iov.push_back(iovec{out.data(), sizeof(uint32_t)});
+      iov.push_back(iovec{out.data() + sizeof(uint32_t), msg_size});
+    }
+  }
+
+  std::vector<iovec> iov;
+  std::vector<iovec> scratch;
+};
+
+} // namespace
+
+// Baseline: one syscall per frame.
+BENCHMARK_DEFINE_F(socket_batching_posix, send_each)(benchmark::State& state) {
+  run(state, posix_write_all, posix_read_all);
+}
+
+BENCHMARK_REGISTER_F(socket_batching_posix, send_each)->Apply(batching_args);
+
+// Ideal: one syscall per batch (unless the kernel accepts only parts of it).
+BENCHMARK_DEFINE_F(socket_batching_posix, sendmsg)(benchmark::State& state) {
+  for (auto _ : state) {
+    scratch.assign(iov.begin(), iov.end());
+    if (!posix_sendmsg_all(snd_sock, scratch.data(), scratch.size()))
+      CAF_CRITICAL("failed to write batch");
+    if (!posix_read_all(snd_sock, ack))
+      CAF_CRITICAL("failed to read acknowledgement");
+  }
+  auto num_messages = static_cast<int64_t>(state.iterations() * depth);
+  state.SetItemsProcessed(num_messages);
+  state.SetBytesProcessed(num_messages * static_cast<int64_t>(msg_size));
+}
+
+BENCHMARK_REGISTER_F(socket_batching_posix, sendmsg)->Apply(batching_args);
+
+#endif // CAF_POSIX
+
+namespace {
+
+// Writes `n` messages after calling `emit(n)`, producing at most
+// `max_per_cycle` of them per call to prepare_send.
+class source_msg_application : public net::lp::upper_layer {
+public:
+  explicit source_msg_application(const byte_buffer* payload)
+    : payload_(payload) {
+    // nop
+  }
+
+  void max_per_cycle(size_t value) {
+    max_per_cycle_ = value;
+  }
+
+  void emit(size_t n) {
+    pending_ = n;
+    acked_ = false;
+    down_->write_later();
+  }
+
+  bool acked() const noexcept {
+    return acked_;
+  }
+
+  void prepare_send() override {
+    for (size_t i = 0; i < max_per_cycle_ && pending_ > 0; ++i) {
+      --pending_;
+      down_->begin_message();
+      auto& buf = down_->message_buffer();
+      buf.insert(buf.end(), payload_->begin(), payload_->end());
+      if (!down_->end_message())
+        CAF_CRITICAL("end_message failed");
+    }
+  }
+
+  bool done_sending() override {
+    return pending_ == 0;
+  }
+
+  error start(net::lp::lower_layer* down) override {
+    down->request_messages();
+    down_ = down;
+    return none;
+  }
+
+  ptrdiff_t consume(byte_span msg) override {
+    acked_ = true;
+    return static_cast<ptrdiff_t>(msg.size());
+  }
+
+  void abort(const error&) override {
+    CAF_CRITICAL("abort called");
+  }
+
+private:
+  net::lp::lower_layer* down_ = nullptr;
+  const byte_buffer* payload_;
+  size_t max_per_cycle_ = 1;
+  size_t pending_ = 0;
+  bool acked_ = false;
+};
+
+// Drives the sending side with a multiplexer in the benchmark thread.
+class socket_batching_lpf : public batching_fixture {
+public:
+  void SetUp(const benchmark::State& state) override {
+    batching_fixture::SetUp(state);
+    payload.assign(out.begin() + sizeof(uint32_t), out.end());
+    if (auto err = net::nonblocking(snd_sock, true))
+      CAF_CRITICAL("nonblocking(snd_sock) failed");
+    mpx = net::multiplexer::make(nullptr);
+    mpx->set_thread_id();
+    mpx->apply_updates();
+    if (auto err = mpx->init())
+      CAF_CRITICAL("mpx->init failed");
+    auto app = std::make_unique<source_msg_application>(&payload);
+    app_ptr = app.get();
+    auto framing = net::lp::framing::make(std::move(app));
+    auto transport = net::octet_stream::transport::make(snd_sock,
+                                                        std::move(framing));
+    mgr = net::socket_manager::make(mpx.get(), std::move(transport));
+    if (auto err = mgr->start()) {
+      auto what = "mgr->start failed: "s;
+      what += to_string(err);
+      CAF_CRITICAL(what.c_str());
+    }
+    mpx->apply_updates();
+  }
+
+  void TearDown(const benchmark::State&) override {
+    // The socket manager owns our end, so we only shut down the write channel
+    // here to stop the receiver.
+    std::ignore = net::shutdown_write(snd_sock);
+    receiver.join();
+    mgr = nullptr;
+    mpx = nullptr;
+    close(rcv_sock);
+  }
+
+  void run(benchmark::State& state, size_t max_per_cycle) {
+    app_ptr->max_per_cycle(max_per_cycle);
+    for (auto _ : state) {
+      app_ptr->emit(depth);
+      while (!app_ptr->acked()) {
+        mpx->apply_updates();
+        mpx->poll_once(true);
+      }
+    }
+    auto num_messages = static_cast<int64_t>(state.iterations() * depth);
+    state.SetItemsProcessed(num_messages);
+    state.SetBytesProcessed(num_messages * static_cast<int64_t>(msg_size));
+  }
+
+  byte_buffer payload;
+  net::multiplexer_ptr mpx;
+  net::socket_manager_ptr mgr;
+  source_msg_application* app_ptr = nullptr;
+};
+
+} // namespace
+
+// One message per prepare_send, i.e., one flush per message.
+BENCHMARK_DEFINE_F(socket_batching_lpf, one_per_cycle)
+(benchmark::State& state) {
+  run(state, 1);
+}
+
+BENCHMARK_REGISTER_F(socket_batching_lpf, one_per_cycle)
+  ->Apply(batching_args);
+
+// All messages of a batch in one prepare_send, i.e., one flush per batch.
+BENCHMARK_DEFINE_F(socket_batching_lpf, batched)(benchmark::State& state) {
+  run(state, depth);
+}
+
+BENCHMARK_REGISTER_F(socket_batching_lpf, batched)->Apply(batching_args);
@@ -0,0 +1,255 @@
+#include "latency_histogram.hpp"
+#include "main.hpp"
+
+#include "caf/event_based_actor.hpp"
+#include "caf/exit_reason.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if CAF_VERSION >= 1900
+#  include "caf/disposable.hpp"
+#endif
+
+using namespace caf;
+
+namespace {
+
+// Bounds for the random delays of all timers. The lower bound gives the server
+// in the request_timeout benchmark enough time to answer requests before they
+// time out.
+constexpr auto min_delay = std::chrono::milliseconds{1};
+
+constexpr auto max_delay = std::chrono::milliseconds{10};
+
+int64_t now_ns() {
+  auto t = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+}
+
+// Input and output of a single benchmark run, shared with the actors.
+struct timer_state {
+  // Random delays for all timers of one iteration.
+  std::vector<timespan> delays;
+
+  // Number of timers that get canceled before they fire. Always the first
+  // timers in `delays`, i.e., the canceled timers have random deadlines.
+  size_t num_canceled = 0;
+
+  // Time spent for scheduling the timers, accumulated over all iterations.
+  int64_t schedule_ns = 0;
+
+  // Time between the deadline and the actual firing of a timer.
+  latency_histogram lateness;
+
+  // Number of timers that actually fired, accumulated over all iterations.
+  size_t num_fired = 0;
+
+  void record_lateness(int64_t deadline) {
+    ++num_fired;
+    lateness.record(static_cast<uint64_t>(std::max(now_ns() - deadline,
+                                                   int64_t{0})));
+  }
+};
+
+// Sends `delays.size()` delayed messages to itself. Each message carries its
+// deadline, which allows the receiver to compute how late it arrived.
+behavior delayed_send_actor(event_based_actor* self, timer_state* st) {
+  auto remaining = std::make_shared<size_t>(st->delays.size());
+  auto t0 = now_ns();
+  for (auto delay : st->delays)
+    self->delayed_send(self, delay, now_ns() + delay.count());
+  st->schedule_ns += now_ns() - t0;
+  return {
+    [self, st, remaining](int64_t deadline) {
+      st->record_lateness(deadline);
+      if (--*remaining == 0)
+        self->quit();
+    },
+  };
+}
+
+#if CAF_VERSION >= 1900
+
+// Schedules actions via run_delayed and disposes the first `num_canceled`
+// before any of them had a chance to fire.
+behavior run_delayed_actor(event_based_actor* self, timer_state* st) {
+  auto remaining = std::make_shared<size_t>(st->delays.size()
+                                            - st->num_canceled);
+  std::vector<disposable> timeouts;
+  timeouts.reserve(st->delays.size());
+  auto t0 = now_ns();
+  for (auto delay : st->delays) {
+    auto deadline = now_ns() + delay.count();
+    auto on_timeout = [self, st, remaining, deadline] {
+      st->record_lateness(deadline);
+      if (--*remaining == 0)
+        self->quit();
+    };
+    timeouts.emplace_back(self->run_delayed(delay, on_timeout));
+  }
+  for (size_t i = 0; i < st->num_canceled; ++i)
+    timeouts[i].dispose();
+  st->schedule_ns += now_ns() - t0;
+  if (*remaining == 0)
+    self->quit();
+  // Keeps the actor alive until all remaining actions ran.
+  return {
+    [](int64_t) {},
+  };
+}
+
+#endif
+
+#if CAF_VERSION >= 1800
+
+// Responds immediately to the first `num_answered` requests and never to the
+// remaining ones.
+behavior lazy_server(event_based_actor* self, size_t num_answered) {
+  auto answered = std::make_shared<size_t>(0);
+  auto pending = std::make_shared<std::vector<response_promise>>();
+  return {
+    [self, answered, pending, num_answered](int64_t x) {
+      auto rp = self->make_response_promise();
+      if (*answered < num_answered) {
+        ++*answered;
+        rp.deliver(x);
+      } else {
+        pending->push_back(rp);
+      }
+      return rp;
+    },
+  };
+}
+
+// Sends one request per delay, using the delay as timeout. Answered requests
+// cancel their timeout, all others fail with a timeout error.
+void request_timeout_actor(event_based_actor* self, actor server,
+                           timer_state* st) {
+  auto remaining = std::make_shared<size_t>(st->delays.size());
+  auto done = [self, server, remaining] {
+    if (--*remaining == 0)
+      self->send_exit(server, exit_reason::user_shutdown);
+  };
+  auto t0 = now_ns();
+  for (auto delay : st->delays) {
+    auto deadline = now_ns() + delay.count();
+    self->request(server, delay, int64_t{0})
+      .then([done](int64_t) { done(); },
+            [st, done, deadline](error&) {
+              st->record_lateness(deadline);
+              done();
+            });
+  }
+  st->schedule_ns += now_ns() - t0;
+}
+
+#endif
+
+// Passes the number of timers and the percentage of canceled timers. Always
+// passes 0 as cancel rate to benchmarks that cannot cancel their timers.
+void timer_counts(benchmark::internal::Benchmark* bench) {
+  bench->ArgsProduct({{1'000, 10'000, 100'000, 1'000'000}, {0}});
+  bench->ArgNames({"timers", "cancel_pct"});
+}
+
+void timer_counts_and_cancel_rates(benchmark::internal::Benchmark* bench) {
+  bench->ArgsProduct({{1'000, 10'000, 100'000, 1'000'000}, {0, 50, 90}});
+  bench->ArgNames({"timers", "cancel_pct"});
+}
+
+} // namespace
+
+class timers : public base_fixture {
+public:
+  caf_context_ptr context;
+
+  timer_state st;
+
+  void SetUp(const benchmark::State& state) override {
+    context = make_caf_context();
+    auto n = static_cast<size_t>(state.range(0));
+    std::minstd_rand engine{42};
+    std::uniform_int_distribution<timespan::rep> dist{to_ns(min_delay),
+                                                      to_ns(max_delay)};
+    st.delays.clear();
+    st.delays.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+      st.delays.emplace_back(dist(engine));
+    st.num_canceled = n * static_cast<size_t>(state.range(1)) / 100;
+    st.schedule_ns = 0;
+    st.lateness.reset();
+    st.num_fired = 0;
+  }
+
+  void TearDown(const ::benchmark::State&) override {
+    context.reset();
+  }
+
+  // Calls `init` once per iteration and reports scheduling cost, timer
+  // throughput, the observed cancel rate and the lateness of all fired timers.
+  template <class Init>
+  void run(benchmark::State& state, const std::string& name, Init init) {
+    using benchmark::Counter;
+    auto& sys = context->sys;
+    for (auto _ : state) {
+      init(sys);
+      sys.await_all_actors_done();
+    }
+    auto n = static_cast<double>(st.delays.size());
+    state.counters["timers"] = Counter(n, Counter::kIsIterationInvariantRate);
+    auto total = n * static_cast<double>(state.iterations());
+    state.counters["schedule_ns"] = static_cast<double>(st.schedule_ns)
+                                    / total;
+    state.counters["observed_cancel_pct"]
+      = 100.0 * (1.0 - static_cast<double>(st.num_fired) / total);
+    st.lateness.report(state, "timers/" + name + "/timers:"
+                                + std::to_string(state.range(0))
+                                + "/cancel_pct:"
+                                + std::to_string(state.range(1)));
+  }
+
+private:
+  template <class Duration>
+  static timespan::rep to_ns(Duration x) {
+    return std::chrono::duration_cast<timespan>(x).count();
+  }
+};
+
+BENCHMARK_DEFINE_F(timers, delayed_send)(benchmark::State& state) {
+  run(state, "delayed_send",
+      [this](actor_system& sys) { sys.spawn(delayed_send_actor, &st); });
+}
+
+BENCHMARK_REGISTER_F(timers, delayed_send)->Apply(timer_counts);
+
+#if CAF_VERSION >= 1800
+
+BENCHMARK_DEFINE_F(timers, request_timeout)(benchmark::State& state) {
+  run(state, "request_timeout", [this](actor_system& sys) {
+    auto server = sys.spawn(lazy_server, st.num_canceled);
+    sys.spawn(request_timeout_actor, server, &st);
+  });
+}
+
+BENCHMARK_REGISTER_F(timers, request_timeout)
+  ->Apply(timer_counts_and_cancel_rates);
+
+#endif
+
+#if CAF_VERSION >= 1900
+
+BENCHMARK_DEFINE_F(timers, run_delayed)(benchmark::State& state) {
+  run(state, "run_delayed",
+      [this](actor_system& sys) { sys.spawn(run_delayed_actor, &st); });
+}
+
+BENCHMARK_REGISTER_F(timers, run_delayed)
+  ->Apply(timer_counts_and_cancel_rates);
+
+#endif
@@ -0,0 +1,264 @@
+#include "main.hpp"
+
+#if CAF_VERSION >= 1800
+
+#  include "caf/event_based_actor.hpp"
+#  include "caf/exit_reason.hpp"
+#  include "caf/typed_actor.hpp"
+#  include "caf/typed_event_based_actor.hpp"
+
+#  include <cstdint>
+#  include <memory>
+
+using namespace caf;
+
+namespace {
+
+// Number of messages or requests per iteration.
+constexpr size_t num_messages = 10'000;
+
+// -- the same protocols as typed and untyped interfaces -----------------------
+
+using typed_sink_actor = typed_actor<result<void>(foo), result<void>(bar)>;
+
+using typed_pong_actor = typed_actor<result<foo>(foo), result<bar>(bar)>;
+
+// Quits after receiving `n` messages.
+behavior untyped_sink(event_based_actor* self, size_t n) {
+  auto remaining = std::make_shared<size_t>(n);
+  auto on_message = [self, remaining] {
+    if (--*remaining == 0)
+      self->quit();
+  };
+  return {
+    [on_message](const foo&) { on_message(); },
+    [on_message](const bar&) { on_message(); },
+  };
+}
+
+typed_sink_actor::behavior_type typed_sink(typed_sink_actor::pointer self,
+                                           size_t n) {
+  auto remaining = std::make_shared<size_t>(n);
+  auto on_message = [self, remaining] {
+    if (--*remaining == 0)
+      self->quit();
+  };
+  return {
+    [on_message](const foo&) { on_message(); },
+    [on_message](const bar&) { on_message(); },
+  };
+}
+
+behavior untyped_pong() {
+  return {
+    [](const foo& x) { return x; },
+    [](const bar& x) { return x; },
+  };
+}
+
+typed_pong_actor::behavior_type typed_pong() {
+  return {
+    [](const foo& x) { return x; },
+    [](const bar& x) { return x; },
+  };
+}
+
+// Forwards all requests to a linked worker, which then responds directly to
+// the client.
+behavior untyped_proxy(event_based_actor* self) {
+  auto worker = self->spawn<linked>(untyped_pong);
+  return {
+    [self, worker](const foo& x) { return self->delegate(worker, x); },
+    [self, worker](const bar& x) { return self->delegate(worker, x); },
+  };
+}
+
+typed_pong_actor::behavior_type typed_proxy(typed_pong_actor::pointer self) {
+  auto worker = self->spawn<linked>(typed_pong);
+  return {
+    [self, worker](const foo& x) { return self->delegate(worker, x); },
+    [self, worker](const bar& x) { return self->delegate(worker, x); },
+  };
+}
+
+// -- clients ------------------------------------------------------------------
+
+template <class T, class Handle>
+void sender(event_based_actor* self, Handle sink) {
+  auto value = make_sample<T>();
+  for (size_t i = 0; i < num_messages; ++i)
+    self->send(sink, value);
+}
+
+// Sends all requests at once and shuts down the server after receiving all
+// responses.
+template <class T, class Handle>
+void requester(event_based_actor* self, Handle server) {
+  auto remaining = std::make_shared<size_t>(num_messages);
+  auto value = make_sample<T>();
+  for (size_t i = 0; i < num_messages; ++i)
+    self->request(server, infinite, value)
+      .then([self, server, remaining](const T&) {
+        if (--*remaining == 0)
+          self->send_exit(server, exit_reason::user_shutdown);
+      });
+}
+
+} // namespace
+
+class typed_actors : public base_fixture {
+public:
+  caf_context_ptr context;
+
+  void SetUp(const benchmark::State& state) override {
+    context = make_caf_context(static_cast<size_t>(state.range(0)));
+  }
+
+  void TearDown(const ::benchmark::State&) override {
+    context.reset();
+  }
+
+  // Calls `init` once per iteration and waits for all actors to terminate.
+  template <class Init>
+  void run(benchmark::State& state, Init init) {
+    auto& sys = context->sys;
+    for (auto _ : state) {
+      init(sys);
+      sys.await_all_actors_done();
+    }
+    state.counters["messages"] = benchmark::Counter(
+      num_messages, benchmark::Counter::kIsIterationInvariantRate);
+  }
+};
+
+// -- send ---------------------------------------------------------------------
+
+BENCHMARK_DEFINE_F(typed_actors, send_untyped_foo)(benchmark::State& state) {
+  run(state, [](actor_system& sys) {
+    sys.spawn(sender<foo, actor>, sys.spawn(untyped_sink, num_messages));
+  });
+}
+
+BENCHMARK_REGISTER_F(typed_actors, send_untyped_foo)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(typed_actors, send_typed_foo)(benchmark::State& state) {
+  run(state, [](actor_system& sys) {
+    sys.spawn(sender<foo, typed_sink_actor>,
+              sys.spawn(typed_sink, num_messages));
+  });
+}
+
+BENCHMARK_REGISTER_F(typed_actors, send_typed_foo)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(typed_actors, send_untyped_bar)(benchmark::State& state) {
+  run(state, [](actor_system& sys) {
+    sys.spawn(sender<bar, actor>, sys.spawn(untyped_sink, num_messages));
+  });
+}
+
+BENCHMARK_REGISTER_F(typed_actors, send_untyped_bar)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(typed_actors, send_typed_bar)(benchmark::State& state) {
+  run(state, [](actor_system& sys) {
+    sys.spawn(sender<bar, typed_sink_actor>,
+              sys.spawn(typed_sink, num_messages));
+  });
+}
+
+BENCHMARK_REGISTER_F(typed_actors, send_typed_bar)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+// -- request().then -----------------------------------------------------------
+
+BENCHMARK_DEFINE_F(typed_actors, request_untyped_foo)(benchmark::State& state) {
+  run(state, [](actor_system& sys) {
+    sys.spawn(requester<foo, actor>, sys.spawn(untyped_pong));
+  });
+}
+
+BENCHMARK_REGISTER_F(typed_actors, request_untyped_foo)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(typed_actors, request_typed_foo)(benchmark::State& state) {
+  run(state, [](actor_system& sys) {
+    sys.spawn(requester<foo, typed_pong_actor>, sys.spawn(typed_pong));
+  });
+}
+
+BENCHMARK_REGISTER_F(typed_actors, request_typed_foo)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(typed_actors, request_untyped_bar)(benchmark::State& state) {
+  run(state, [](actor_system& sys) {
+    sys.spawn(requester<bar, actor>, sys.spawn(untyped_pong));
+  });
+}
+
+BENCHMARK_REGISTER_F(typed_actors, request_untyped_bar)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(typed_actors, request_typed_bar)(benchmark::State& state) {
+  run(state, [](actor_system& sys) {
+    sys.spawn(requester<bar, typed_pong_actor>, sys.spawn(typed_pong));
+  });
+}
+
+BENCHMARK_REGISTER_F(typed_actors, request_typed_bar)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+// -- delegate -----------------------------------------------------------------
+
+BENCHMARK_DEFINE_F(typed_actors, delegate_untyped_foo)
+(benchmark::State& state) {
+  run(state, [](actor_system& sys) {
+    sys.spawn(requester<foo, actor>, sys.spawn(untyped_proxy));
+  });
+}
+
+BENCHMARK_REGISTER_F(typed_actors, delegate_untyped_foo)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(typed_actors, delegate_typed_foo)(benchmark::State& state) {
+  run(state, [](actor_system& sys) {
+    sys.spawn(requester<foo, typed_pong_actor>, sys.spawn(typed_proxy));
+  });
+}
+
+BENCHMARK_REGISTER_F(typed_actors, delegate_typed_foo)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(typed_actors, delegate_untyped_bar)
+(benchmark::State& state) {
+  run(state, [](actor_system& sys) {
+    sys.spawn(requester<bar, actor>, sys.spawn(untyped_proxy));
+  });
+}
+
+BENCHMARK_REGISTER_F(typed_actors, delegate_untyped_bar)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+BENCHMARK_DEFINE_F(typed_actors, delegate_typed_bar)(benchmark::State& state) {
+  run(state, [](actor_system& sys) {
+    sys.spawn(requester<bar, typed_pong_actor>, sys.spawn(typed_proxy));
+  });
+}
+
+BENCHMARK_REGISTER_F(typed_actors, delegate_typed_bar)
+  ->Apply(worker_counts)
+  ->ArgName("workers");
+
+#endif
@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+"""
+Compares Google Benchmark JSON output of several CAF builds side by side.
+
+Usage:
+  compare.py [--metric=real_time|cpu_time] [--alpha=0.05] [--baseline=TAG]
+             TAG=FILE [TAG=FILE...]
+
+Each FILE must be the output of running micro-benchmark with
+`--benchmark_repetitions=N --benchmark_out_format=json`. For every benchmark,
+the script prints one table with a row per tag that shows the mean, the 95%
+confidence interval, the speedup relative to the baseline (the first tag by
+default) and whether the difference to the baseline is significant according
+to Welch's t-test.
+"""
+
+import argparse
+import json
+import math
+import sys
+
+# -- statistics helpers (stdlib only) -----------------------------------------
+
+
+def betacf(a, b, x):
+    # Continued fraction for the incomplete beta function (modified Lentz).
+    tiny = 1e-300
+    qab = a + b
+    qap = a + 1.0
+    qam = a - 1.0
+    c = 1.0
+    d = 1.0 - qab * x / qap
+    d = tiny if abs(d) < tiny else d
+    d = 1.0 / d
+    h = d
+    for m in range(1, 201):
+        m2 = 2 * m
+        aa = m * (b - m) * x / ((qam + m2) * (a + m2))
+        d = 1.0 + aa * d
+        d = tiny if abs(d) < tiny else d
+        c = 1.0 + aa / c
+        c = tiny if abs(c) < tiny else c
+        d = 1.0 / d
+        h *= d * c
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2))
+        d = 1.0 + aa * d
+        d = tiny if abs(d) < tiny else d
+        c = 1.0 + aa / c
+        c = tiny if abs(c) < tiny else c
+        d = 1.0 / d
+        delta = d * c
+        h *= delta
+        if abs(delta - 1.0) < 1e-12:
+            break
+    return h
+
+
+def betai(a, b, x):
+    # Regularized incomplete beta function I_x(a, b).
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    lbeta = math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b)
+    front = math.exp(lbeta + a * math.log(x) + b * math.log(1.0 - x))
+    if x < (a + 1.0) / (a + b + 2.0):
+        return front * betacf(a, b, x) / a
+    return 1.0 - front * betacf(b, a, 1.0 - x) / b
+
+
+def t_sf_two_sided(t, df):
+    # Two-sided p-value for Student's t distribution.
+    return betai(df / 2.0, 0.5, df / (df + t * t))
+
+
+def t_quantile(p, df):
+    # Returns t such that P(|T| <= t) = p, found via bisection.
+    lo, hi = 0.0, 1e3
+    for _ in range(200):
+        mid = (lo + hi) / 2.0
+        if 1.0 - t_sf_two_sided(mid, df) < p:
+            lo = mid
+        else:
+            hi = mid
+    return (lo + hi) / 2.0
+
+
+class Sample:
+    def __init__(self, values):
+        self.n = len(values)
+        self.mean = sum(values) / self.n
+        if self.n > 1:
+            sq = sum((x - self.mean) ** 2 for x in values)
+            self.var = sq / (self.n - 1)
+        else:
+            self.var = 0.0
+
+    def ci(self, level=0.95):
+        # Half-width of the confidence interval for the mean.
+        if self.n < 2:
+            return float('nan')
+        return t_quantile(level, self.n - 1) * math.sqrt(self.var / self.n)
+
+
+def welch(lhs, rhs):
+    # Returns the two-sided p-value of Welch's t-test.
+    if lhs.n < 2 or rhs.n < 2:
+        return float('nan')
+    vl = lhs.var / lhs.n
+    vr = rhs.var / rhs.n
+    if vl + vr == 0.0:
+        return 0.0 if lhs.mean != rhs.mean else 1.0
+    t = (lhs.mean - rhs.mean) / math.sqrt(vl + vr)
+    df = (vl + vr) ** 2 / (vl ** 2 / (lhs.n - 1) + vr ** 2 / (rhs.n - 1))
+    return t_sf_two_sided(abs(t), df)
+
+
+# -- loading of benchmark results ---------------------------------------------
+
+
+def load(path, metric):
+    # Returns a dict that maps benchmark names to (unit, [values]).
+    with open(path) as f:
+        doc = json.load(f)
+    result = {}
+    for entry in doc.get('benchmarks', []):
+        if entry.get('run_type', 'iteration') != 'iteration':
+            continue
+        if 'error_occurred' in entry and entry['error_occurred']:
+            continue
+        name = entry.get('run_name', entry['name'])
+        unit = entry.get('time_unit', 'ns')
+        result.setdefault(name, (unit, []))[1].append(entry[metric])
+    return result
+
+
+# -- report generation --------------------------------------------------------
+
+
+def fmt(value):
+    if math.isnan(value):
+        return '-'
+    return '{:.4g}'.format(value)
+
+
+def report(out, name, unit, rows, alpha):
+    header = ['tag', 'n', 'mean [' + unit + ']', '95% CI', 'speedup',
+              'p-value', 'significant']
+    lines = [header]
+    base = rows[0][1]
+    for tag, sample in rows:
+        if sample is None:
+            lines.append([tag, '0', '-', '-', '-', '-', '-'])
+            continue
+        speedup = base.mean / sample.mean if base and sample.mean else 1.0
+        if sample is base:
+            pval = float('nan')
+            flag = '(baseline)'
+        else:
+            pval = welch(base, sample) if base else float('nan')
+            flag = '-' if math.isnan(pval) else ('yes' if pval < alpha else 'no')
+        lines.append([tag, str(sample.n), fmt(sample.mean),
+                      '+/- ' + fmt(sample.ci()), fmt(speedup) + 'x',
+                      fmt(pval), flag])
+    widths = [max(len(line[i]) for line in lines) for i in range(len(header))]
+    out.write(name + '\n')
+    for line in lines:
+        cells = [cell.rjust(widths[i]) if i > 0 else cell.ljust(widths[i])
+                 for i, cell in enumerate(line)]
+        out.write('  ' + '  '.join(cells) + '\n')
+    out.write('\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('--metric', default='real_time',
+                        choices=['real_time', 'cpu_time'])
+    parser.add_argument('--alpha', type=float, default=0.05,
+                        help='significance level for Welch\'s t-test')
+    parser.add_argument('--baseline', help='tag to compare against')
+    parser.add_argument('inputs', nargs='+', metavar='TAG=FILE')
+    args = parser.parse_args()
+    tags = []
+    results = {}
+    for arg in args.inputs:
+        tag, sep, path = arg.partition('=')
+        if not sep:
+            sys.exit('expected TAG=FILE, got ' + arg)
+        tags.append(tag)
+        results[tag] = load(path, args.metric)
+    if args.baseline:
+        if args.baseline not in results:
+            sys.exit('unknown baseline tag: ' + args.baseline)
+        tags.remove(args.baseline)
+        tags.insert(0, args.baseline)
+    names = []
+    for tag in tags:
+        for name in results[tag]:
+            if name not in names:
+                names.append(name)
+    for name in names:
+        unit = next(results[t][name][0] for t in tags if name in results[t])
+        rows = [(t, Sample(results[t][name][1]) if name in results[t] else None)
+                for t in tags]
+        if rows[0][1] is None:
+            continue
+        report(sys.stdout, name, unit, rows, args.alpha)
+
+
+if __name__ == '__main__':
+    main()